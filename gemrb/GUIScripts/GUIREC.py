@@ -86,9 +86,17 @@ def InitRecordsWindow (Window):
 	return
 
 def UpdateRecordsWindow (Window):
-	global alignment_help
-
 	pc = GemRB.GameGetSelectedPCSingle ()
+	fetched = FetchStats (pc)
+	try:
+		FillRecordsWindow (Window, pc)
+	finally:
+		if fetched:
+			ForgetStats ()
+	return
+
+def FillRecordsWindow (Window, pc):
+	global alignment_help
 
 	#update mage school
 	GemRB.SetVar ("MAGESCHOOL", 0)
@@ -134,38 +142,38 @@ def UpdateRecordsWindow (Window):
 
 	# armorclass
 	Label = Window.GetControl (0x10000028)
-	ac = GemRB.GetPlayerStat (pc, IE_ARMORCLASS)
+	ac = GS (pc, IE_ARMORCLASS)
 	Label.SetText (str (ac))
 	Label.SetTooltip (17183)
 
 	# hp now
 	Label = Window.GetControl (0x10000029)
-	Label.SetText (str (GemRB.GetPlayerStat (pc, IE_HITPOINTS)))
+	Label.SetText (str (GS (pc, IE_HITPOINTS)))
 	Label.SetTooltip (17184)
 
 	# hp max
 	Label = Window.GetControl (0x1000002a)
-	Label.SetText (str (GemRB.GetPlayerStat (pc, IE_MAXHITPOINTS)))
+	Label.SetText (str (GS (pc, IE_MAXHITPOINTS)))
 	Label.SetTooltip (17378)
 
 	# stats
-	sstr = GemRB.GetPlayerStat (pc, IE_STR)
-	sstrx = GemRB.GetPlayerStat (pc, IE_STREXTRA)
+	sstr = GS (pc, IE_STR)
+	sstrx = GS (pc, IE_STREXTRA)
 	cstr = GetStatColor (pc, IE_STR)
 	if sstrx > 0 and sstr==18:
 		sstr = "%d/%02d" %(sstr, sstrx % 100)
 	else:
 		sstr = str (sstr)
 
-	sint = str (GemRB.GetPlayerStat (pc, IE_INT))
+	sint = str (GS (pc, IE_INT))
 	cint = GetStatColor (pc, IE_INT)
-	swis = str (GemRB.GetPlayerStat (pc, IE_WIS))
+	swis = str (GS (pc, IE_WIS))
 	cwis = GetStatColor (pc, IE_WIS)
-	sdex = str (GemRB.GetPlayerStat (pc, IE_DEX))
+	sdex = str (GS (pc, IE_DEX))
 	cdex = GetStatColor (pc, IE_DEX)
-	scon = str (GemRB.GetPlayerStat (pc, IE_CON))
+	scon = str (GS (pc, IE_CON))
 	ccon = GetStatColor (pc, IE_CON)
-	schr = str (GemRB.GetPlayerStat (pc, IE_CHR))
+	schr = str (GS (pc, IE_CHR))
 	cchr = GetStatColor (pc, IE_CHR)
 
 	Label = Window.GetControl (0x1000002f)
@@ -198,20 +206,20 @@ def UpdateRecordsWindow (Window):
 	Label.SetText (ClassTitle)
 
 	# race
-	text = CommonTables.Races.GetValue (CommonTables.Races.FindValue (3, GemRB.GetPlayerStat (pc, IE_RACE)) , 0)
+	text = CommonTables.Races.GetValue (CommonTables.Races.FindValue (3, GS (pc, IE_RACE)) , 0)
 
 	Label = Window.GetControl (0x1000000f)
 	Label.SetText (text)
 
 	# alignment
-	text = CommonTables.Aligns.FindValue (3, GemRB.GetPlayerStat (pc, IE_ALIGNMENT))
+	text = CommonTables.Aligns.FindValue (3, GS (pc, IE_ALIGNMENT))
 	text = CommonTables.Aligns.GetValue (text, 0)
 	Label = Window.GetControl (0x10000010)
 	Label.SetText (text)
 
 	# gender
 	Label = Window.GetControl (0x10000011)
-	if GemRB.GetPlayerStat (pc, IE_SEX) == 1:
+	if GS (pc, IE_SEX) == 1:
 		Label.SetText (7198)
 	else:
 		Label.SetText (7199)
@@ -234,14 +242,14 @@ def OpenRecReformPartyWindow ():
 
 #don't allow exporting polymorphed or dead characters
 def Exportable(pc):
-	if not (GemRB.GetPlayerStat (pc, IE_MC_FLAGS)&MC_EXPORTABLE): return False
-	if GemRB.GetPlayerStat (pc, IE_POLYMORPHED): return False
-	if GemRB.GetPlayerStat (pc, IE_STATE_ID)&STATE_DEAD: return False
+	if not (GS (pc, IE_MC_FLAGS)&MC_EXPORTABLE): return False
+	if GS (pc, IE_POLYMORPHED): return False
+	if GS (pc, IE_STATE_ID)&STATE_DEAD: return False
 	return True
 
 def GetStatColor (pc, stat):
-	a = GemRB.GetPlayerStat (pc, stat)
-	b = GemRB.GetPlayerStat (pc, stat, 1)
+	a = GS (pc, stat)
+	b = GB (pc, stat)
 	if a==b:
 		return {'r' : 255, 'g' : 255, 'b' : 255}
 	if a<b:
@@ -250,17 +258,43 @@ def GetStatColor (pc, stat):
 
 # GemRB.GetPlayerStat wrapper that only returns nonnegative values
 def GSNN (pc, stat):
-	val = GemRB.GetPlayerStat (pc, stat)
+	val = GS (pc, stat)
 	if val >= 0:
 		return val
 	else:
 		return 0
 
+# the stats of the pc on the record sheet, queried in one go instead of
+# with a GetPlayerStat call for each of them while the sheet is filled
+StatsPC = None
+Stats = BaseStats = ()
+
+def FetchStats (pc):
+	"""Queries all the stats of pc for GS and GB, returns False if they were already there."""
+	global StatsPC, Stats, BaseStats
+
+	if StatsPC == pc:
+		return False
+	StatsPC = pc
+	Stats = GemRB.GetPlayerStats (pc)
+	BaseStats = GemRB.GetPlayerStats (pc, 1)
+	return True
+
+def ForgetStats ():
+	global StatsPC
+
+	StatsPC = None
+	return
+
 # shorthand wrappers for Modified/Base stat and ability bonus
 def GS (pc, stat):
+	if pc == StatsPC and stat < len (Stats):
+		return Stats[stat]
 	return GemRB.GetPlayerStat (pc, stat)
 
 def GB (pc, stat):
+	if pc == StatsPC and stat < len (BaseStats):
+		return BaseStats[stat]
 	return GemRB.GetPlayerStat (pc, stat, 1)
 
 def GA (pc, stat, col):
@@ -270,6 +304,14 @@ def GA (pc, stat, col):
 # LevelDiff is used only from the level up code and holds the level
 # difference for each class
 def GetStatOverview (pc, LevelDiff=[0,0,0]):
+	fetched = FetchStats (pc)
+	try:
+		return GetStatOverviewText (pc, LevelDiff)
+	finally:
+		if fetched:
+			ForgetStats ()
+
+def GetStatOverviewText (pc, LevelDiff):
 	cdet = GemRB.GetCombatDetails (pc, 0)
 
 	outputtext = GetClassTitles (pc,LevelDiff)
@@ -306,7 +348,7 @@ def GetClassTitles (pc,LevelDiff):
 	Class = GUICommon.GetClassRowName (pc)
 	Dual = GUICommon.IsDualClassed (pc, 1)
 	Multi = GUICommon.IsMultiClassed (pc, 1)
-	XP = GemRB.GetPlayerStat (pc, IE_XP)
+	XP = GS (pc, IE_XP)
 	LevelDrain = GS (pc, IE_LEVELDRAIN)
 
 	if GS (pc, IE_STATE_ID) & STATE_DEAD:
@@ -315,7 +357,7 @@ def GetClassTitles (pc,LevelDiff):
 
 	if Multi[0] > 1: # we're multiclassed
 		print "\tMulticlassed"
-		Levels = [GemRB.GetPlayerStat (pc, IE_LEVEL), GemRB.GetPlayerStat (pc, IE_LEVEL2), GemRB.GetPlayerStat (pc, IE_LEVEL3)]
+		Levels = [GS (pc, IE_LEVEL), GS (pc, IE_LEVEL2), GS (pc, IE_LEVEL3)]
 
 		stats.append ( (19721,1,'c') )
 		for i in range (Multi[0]):
@@ -337,7 +379,7 @@ def GetClassTitles (pc,LevelDiff):
 		print "\tDual classed"
 		stats.append ( (19722,1,'c') )
 
-		Levels = [GemRB.GetPlayerStat (pc, IE_LEVEL), GemRB.GetPlayerStat (pc, IE_LEVEL2), GemRB.GetPlayerStat (pc, IE_LEVEL3)]
+		Levels = [GS (pc, IE_LEVEL), GS (pc, IE_LEVEL2), GS (pc, IE_LEVEL3)]
 
 		# the levels are stored in the class order (eg. FIGHTER_MAGE)
 		# the current active class does not matter!
@@ -350,7 +392,7 @@ def GetClassTitles (pc,LevelDiff):
 		ClassTitle = CommonTables.Classes.GetValue (Class, "CAP_REF", GTV_REF)
 		GemRB.SetToken ("CLASS", ClassTitle)
 		GemRB.SetToken ("LEVEL", str (Levels[0]-LevelDrain))
-		XP2 = GemRB.GetPlayerStat (pc, IE_XP)
+		XP2 = GS (pc, IE_XP)
 		GemRB.SetToken ("EXPERIENCE", str (XP2) )
 		if LevelDrain:
 			stats.append ( (GemRB.GetString (19720),1,'d') )
@@ -391,7 +433,7 @@ def GetClassTitles (pc,LevelDiff):
 		stats.append ("\n")
 	else: # single classed
 		print "\tSingle classed"
-		Level = GemRB.GetPlayerStat (pc, IE_LEVEL) + LevelDiff[0]
+		Level = GS (pc, IE_LEVEL) + LevelDiff[0]
 		GemRB.SetToken ("LEVEL", str (Level-LevelDrain))
 		GemRB.SetToken ("EXPERIENCE", str (XP) )
 		if LevelDrain:
@@ -585,8 +627,8 @@ def GetAbilityBonuses(pc):
 	stats = []
 	# 10315 Ability bonuses
 	stats.append (10315)
-	value = GemRB.GetPlayerStat (pc, IE_STR)
-	ex = GemRB.GetPlayerStat (pc, IE_STREXTRA)
+	value = GS (pc, IE_STR)
+	ex = GS (pc, IE_STREXTRA)
 	# 10332 to hit
 	stats.append ( (10332, GemRB.GetAbilityBonus (IE_STR,0,value,ex), 'p') )
 	# 10336 damage
@@ -507,8 +507,16 @@ def OpenItemAmountWindow (btn, slot):
 	Window.ShowModal (MODAL_SHADOW_GRAY)
 	return
 
-def UpdateSlot (pc, slot):
-	"""Updates a specific slot."""
+def UpdateSlots (pc, SlotCount):
+	"""Updates all the slots, querying their items in one go."""
+
+	Items = GemRB.GetSlotItems (pc, range (1, SlotCount+1))
+	for i in range (SlotCount):
+		UpdateSlot (pc, i, Items[i])
+	return
+
+def UpdateSlot (pc, slot, slot_item=-1):
+	"""Updates a specific slot, slot_item is its item if it was already queried."""
 
 	Window = GemRB.GetView("WIN_INV")
 
@@ -527,7 +535,8 @@ def UpdateSlot (pc, slot):
 		itemname = ""
 
 	Button = Window.GetControl (ControlID)
-	slot_item = GemRB.GetSlotItem (pc, slot+1)
+	if slot_item == -1:
+		slot_item = GemRB.GetSlotItem (pc, slot+1)
 
 	Button.SetEvent (IE_GUI_BUTTON_ON_DRAG_DROP, OnDragItem)
 	Button.SetFlags (IE_GUI_BUTTON_NO_IMAGE, OP_NAND)
@@ -46,9 +46,7 @@ def GetUsableMemorizedSpells(actor, BookType):
 	memorizedSpells = []
 	spellResRefs = []
 	for level in range (20): # Saradas NPC teaches you a level 14 special ...
-		spellCount = GemRB.GetMemorizedSpellsCount (actor, BookType, level, False)
-		for i in range (spellCount):
-			Spell0 = GemRB.GetMemorizedSpell (actor, BookType, level, i)
+		for Spell0 in GemRB.GetMemorizedSpellList (actor, BookType, level):
 			if not Spell0["Flags"]:
 				# depleted, so skip
 				continue
@@ -83,9 +81,7 @@ def GetKnownSpells(actor, BookType):
 	knownSpells = []
 	spellResRefs = []
 	for level in range (9):
-		spellCount = GemRB.GetKnownSpellsCount (actor, BookType, level)
-		for i in range (spellCount):
-			Spell0 = GemRB.GetKnownSpell (actor, BookType, level, i)
+		for Spell0 in GemRB.GetKnownSpellList (actor, BookType, level):
 			if Spell0["SpellResRef"] in spellResRefs:
 				continue
 			spellResRefs.append (Spell0["SpellResRef"])
@@ -101,9 +97,7 @@ def GetKnownSpellsLevel(actor, BookType, level):
 	knownSpells = []
 	spellResRefs = []
 
-	spellCount = GemRB.GetKnownSpellsCount (actor, BookType, level)
-	for i in range (spellCount):
-		Spell0 = GemRB.GetKnownSpell (actor, BookType, level, i)
+	for Spell0 in GemRB.GetKnownSpellList (actor, BookType, level):
 		if Spell0["SpellResRef"] in spellResRefs:
 			continue
 		spellResRefs.append (Spell0["SpellResRef"])
@@ -123,9 +117,7 @@ def GetMemorizedSpells(actor, BookType, level):
 	memoSpells = []
 	spellResRefs = []
 
-	spellCount = GemRB.GetMemorizedSpellsCount (actor, BookType, level, False)
-	for i in range (spellCount):
-		Spell0 = GemRB.GetMemorizedSpell (actor, BookType, level, i)
+	for Spell0 in GemRB.GetMemorizedSpellList (actor, BookType, level):
 		pos = index(spellResRefs,Spell0["SpellResRef"])
 		if pos!=-1:
 			memoSpells[pos]['KnownCount']+=1
@@ -499,8 +491,7 @@ def UnsetupSpellLevels (pc, TableName, Type, Level):
 # Returns -1 if not found; otherwise, the index of the spell
 def HasSpell (Actor, SpellType, Level, Ref):
 	# loop through each spell in the spell level and check for a matching ref
-	for i in range (GemRB.GetKnownSpellsCount (Actor, SpellType, Level)):
-		Spell = GemRB.GetKnownSpell(Actor, SpellType, Level, i)
+	for i, Spell in enumerate (GemRB.GetKnownSpellList (Actor, SpellType, Level)):
 		if Spell["SpellResRef"].upper() == Ref.upper(): # ensure case is the same
 			return i
 
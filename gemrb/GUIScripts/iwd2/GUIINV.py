@@ -152,8 +152,7 @@ def UpdateInventoryWindow (Window):
 	RefreshInventoryWindow ()
 	# populate inventory slot controls
 	SlotCount = GemRB.GetSlotType (-1)["Count"]
-	for i in range (SlotCount):
-		InventoryCommon.UpdateSlot (pc, i)
+	InventoryCommon.UpdateSlots (pc, SlotCount)
 	return
 
 InventoryCommon.UpdateInventoryWindow = UpdateInventoryWindow
@@ -281,11 +281,12 @@ def GNZS(pc, s1, st, force=False):
 def DisplayGeneral (pc, targetTextArea):
 	global RecordsTextArea
 	RecordsTextArea = targetTextArea
+	Stats = GemRB.GetPlayerStats (pc)
 
 	#levels
 	# get special level penalty for subrace
 	adj = GetECL (pc)
-	levelsum = GemRB.GetPlayerStat (pc, IE_CLASSLEVELSUM)
+	levelsum = Stats[IE_CLASSLEVELSUM]
 	RecordsTextArea.Append ("[color=ffff00]" + GemRB.GetString(40308) + " - " +
                             GemRB.GetString(40309) + ": " + str(levelsum) + "[/color]\n")
 
@@ -324,7 +325,7 @@ def DisplayGeneral (pc, targetTextArea):
 	#experience
 	RecordsTextArea.Append ("\n[color=ffff00]" + GemRB.GetString(17089) + "[/color]\n")
 
-	xp = GemRB.GetPlayerStat (pc, IE_XP)
+	xp = Stats[IE_XP]
 	RecordsTextArea.Append (DelimitedText (36928, xp, 0, ""))
 	tmp = GetNextLevelExp (levelsum, adj, 1)
 	RecordsTextArea.Append (DelimitedText (17091, tmp, 0))
@@ -351,7 +352,7 @@ def DisplayGeneral (pc, targetTextArea):
 
 	#alignment
 	RecordsTextArea.Append ("\n[color=ffff00]" + GemRB.GetString(1049) + "[/color]\n")
-	tmp = CommonTables.Aligns.FindValue (3, GemRB.GetPlayerStat (pc, IE_ALIGNMENT))
+	tmp = CommonTables.Aligns.FindValue (3, Stats[IE_ALIGNMENT])
 	Align = CommonTables.Aligns.GetValue (tmp, 2, GTV_REF)
 	RecordsTextArea.Append ("[p]" + Align + "[/p]")
 
@@ -361,18 +362,18 @@ def DisplayGeneral (pc, targetTextArea):
 	#class features
 	if HasClassFeatures(pc):
 		RecordsTextArea.Append ("\n[color=ffff00]" + GemRB.GetString(40314) + "[/color]\n")
-		tmp = GemRB.GetPlayerStat (pc, IE_TURNUNDEADLEVEL)
+		tmp = Stats[IE_TURNUNDEADLEVEL]
 		if tmp:
 			RecordsTextArea.Append (DelimitedText (12126, tmp, 0))
 		# 1d6 at level 1 and +1d6 every two extra rogue levels
-		tmp = GemRB.GetPlayerStat (pc, IE_LEVELTHIEF)
+		tmp = Stats[IE_LEVELTHIEF]
 		if tmp:
 			tmp = (tmp+1)//2
 			RecordsTextArea.Append (DelimitedText (24898, str(tmp)+"d6", 0))
-		tmp = GemRB.GetPlayerStat (pc, IE_LAYONHANDSAMOUNT)
+		tmp = Stats[IE_LAYONHANDSAMOUNT]
 		if tmp:
 			RecordsTextArea.Append (DelimitedText (12127, tmp, 0))
-		MonkLevel = GemRB.GetPlayerStat (pc, IE_LEVELMONK)
+		MonkLevel = Stats[IE_LEVELMONK]
 		if MonkLevel:
 			AC = GemRB.GetCombatDetails(pc, 0)["AC"]
 			GemRB.SetToken ("number", PlusMinusStat (AC["Wisdom"]))
@@ -381,7 +382,7 @@ def DisplayGeneral (pc, targetTextArea):
 			RecordsTextArea.Append (DelimitedText (39749, MonkLevel*2, 0))
 
 	# favoured enemies; eg Goblins: +2 & Harpies: +1
-	RangerLevel = GemRB.GetPlayerStat (pc, IE_LEVELRANGER)
+	RangerLevel = Stats[IE_LEVELRANGER]
 	if RangerLevel:
 		RangerString = "\n[color=ffff00]"
 		if RangerLevel > 5:
@@ -411,7 +412,7 @@ def DisplayGeneral (pc, targetTextArea):
 	RecordsTextArea.Append ("\n[color=ffff00]" + GemRB.GetString(40315) + "[/color]\n")
 
 	# Weight Allowance
-	tmp = GemRB.GetAbilityBonus( IE_STR, 3, GemRB.GetPlayerStat(pc, IE_STR) )
+	tmp = GemRB.GetAbilityBonus( IE_STR, 3, Stats[IE_STR] )
 	RecordsTextArea.Append (DelimitedText (10338, str(tmp) + " lb."))
 	# constitution bonus to hitpoints
 	tmp = GUICommon.GetAbilityBonus(pc, IE_CON)
@@ -645,7 +646,8 @@ def WeaponOfHand(pc, combatdet, dualwielding, left=0):
 		RecordsTextArea.Append ("\n")
 
 def DisplayWeapons (pc):
-	GS = lambda s, pc=pc: GemRB.GetPlayerStat (pc, s)
+	Stats = GemRB.GetPlayerStats (pc)
+	GS = lambda s: Stats[s]
 
 	###################
 	# Attack Roll Modifiers
@@ -904,6 +906,8 @@ def UpdateRecordsWindow (Window):
 	global RecordsTextArea
 
 	pc = GemRB.GameGetSelectedPCSingle ()
+	Stats = GemRB.GetPlayerStats (pc)
+	BaseStats = GemRB.GetPlayerStats (pc, 1)
 
 	#name
 	Label = Window.GetControl (0x1000000e)
@@ -915,46 +919,46 @@ def UpdateRecordsWindow (Window):
 
 	# armorclass
 	Label = Window.GetControl (0x10000028)
-	Label.SetText (str (GemRB.GetPlayerStat (pc, IE_ARMORCLASS)))
+	Label.SetText (str (Stats[IE_ARMORCLASS]))
 	Label.SetTooltip (17183)
 
 	# hp now
 	Label = Window.GetControl (0x10000029)
-	Label.SetText (str (GemRB.GetPlayerStat (pc, IE_HITPOINTS)))
+	Label.SetText (str (Stats[IE_HITPOINTS]))
 	Label.SetTooltip (17184)
 
 	# hp max
 	Label = Window.GetControl (0x1000002a)
-	Label.SetText (str (GemRB.GetPlayerStat (pc, IE_MAXHITPOINTS)))
+	Label.SetText (str (Stats[IE_MAXHITPOINTS]))
 	Label.SetTooltip (17378)
 
 	#level up
 	Button = Window.GetControl (37)
-	levelsum = GemRB.GetPlayerStat (pc, IE_CLASSLEVELSUM)
-	if GetNextLevelExp(levelsum, GetECL(pc)) <= GemRB.GetPlayerStat (pc, IE_XP):
+	levelsum = Stats[IE_CLASSLEVELSUM]
+	if GetNextLevelExp(levelsum, GetECL(pc)) <= Stats[IE_XP]:
 		Button.SetState (IE_GUI_BUTTON_ENABLED)
 	else:
 		Button.SetState (IE_GUI_BUTTON_DISABLED)
 
 	# stats
 
-	sstr = GemRB.GetPlayerStat (pc, IE_STR)
-	dstr = sstr-GemRB.GetPlayerStat (pc, IE_STR,1)
+	sstr = Stats[IE_STR]
+	dstr = sstr-BaseStats[IE_STR]
 	bstr = GUICommon.GetAbilityBonus (pc, IE_STR)
-	sint = GemRB.GetPlayerStat (pc, IE_INT)
-	dint = sint-GemRB.GetPlayerStat (pc, IE_INT,1)
+	sint = Stats[IE_INT]
+	dint = sint-BaseStats[IE_INT]
 	bint = GUICommon.GetAbilityBonus (pc, IE_INT)
-	swis = GemRB.GetPlayerStat (pc, IE_WIS)
-	dwis = swis-GemRB.GetPlayerStat (pc, IE_WIS,1)
+	swis = Stats[IE_WIS]
+	dwis = swis-BaseStats[IE_WIS]
 	bwis = GUICommon.GetAbilityBonus (pc, IE_WIS)
-	sdex = GemRB.GetPlayerStat (pc, IE_DEX)
-	ddex = sdex-GemRB.GetPlayerStat (pc, IE_DEX,1)
+	sdex = Stats[IE_DEX]
+	ddex = sdex-BaseStats[IE_DEX]
 	bdex = GUICommon.GetAbilityBonus (pc, IE_DEX)
-	scon = GemRB.GetPlayerStat (pc, IE_CON)
-	dcon = scon-GemRB.GetPlayerStat (pc, IE_CON,1)
+	scon = Stats[IE_CON]
+	dcon = scon-BaseStats[IE_CON]
 	bcon = GUICommon.GetAbilityBonus (pc, IE_CON)
-	schr = GemRB.GetPlayerStat (pc, IE_CHR)
-	dchr = schr-GemRB.GetPlayerStat (pc, IE_CHR,1)
+	schr = Stats[IE_CHR]
+	dchr = schr-BaseStats[IE_CHR]
 	bchr = GUICommon.GetAbilityBonus (pc, IE_CHR)
 
 	Label = Window.GetControl (0x1000002f)
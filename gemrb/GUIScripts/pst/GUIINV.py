@@ -161,9 +161,10 @@ def UpdateInventoryWindow (Window = None):
 	row = GemRB.GetPlayerStat (pc, IE_SPECIFIC)
 	slot_list = map (int, AvSlotsTable.GetValue (row, 1, GTV_STR).split( ','))
 
-	# populate inventory slot controls
+	# populate inventory slot controls, querying all the items in one go
+	Items = GemRB.GetSlotItems (pc, [max (slot_list[i], 0)+1 for i in range (46)])
 	for i in range (46):
-		UpdateSlot (pc, i)
+		UpdateSlot (pc, i, Items[i])
 
 ToggleInventoryWindow = GUICommonWindows.CreateTopWinLoader(3, "GUIINV", GUICommonWindows.ToggleWindow, InitInventoryWindow, UpdateInventoryWindow, WINDOW_TOP|WINDOW_HCENTER)
 OpenInventoryWindow = GUICommonWindows.CreateTopWinLoader(3, "GUIINV", GUICommonWindows.OpenWindowOnce, InitInventoryWindow, UpdateInventoryWindow, WINDOW_TOP|WINDOW_HCENTER)
@@ -256,7 +257,8 @@ def RefreshInventoryWindow (Window):
 			Button.SetEvent (IE_GUI_BUTTON_ON_SHIFT_PRESS, None)
  	return
 
-def UpdateSlot (pc, i):
+# slot_item is the item of the slot if it was already queried
+def UpdateSlot (pc, i, slot_item=-1):
 	Window = GemRB.GetView("WIN_INV")
 
 	# NOTE: there are invisible items (e.g. MORTEP) in inaccessible slots
@@ -269,7 +271,8 @@ def UpdateSlot (pc, i):
 	else:
 		slot = slot_list[i]+1
 		SlotType = GemRB.GetSlotType (slot)
-		slot_item = GemRB.GetSlotItem (pc, slot)
+		if slot_item == -1:
+			slot_item = GemRB.GetSlotItem (pc, slot)
 		#PST displays the default weapon in the first slot if nothing else was equipped
 		if slot_item == None and SlotType["ID"] == 10 and GemRB.GetEquippedQuickSlot(pc)==10:
 			slot_item = GemRB.GetSlotItem (pc, 0)
@@ -138,6 +138,8 @@ def UpdateRecordsWindow (Window):
 	global stats_overview, faction_help, alignment_help
 
 	pc = GemRB.GameGetSelectedPCSingle ()
+	Stats = GemRB.GetPlayerStats (pc)
+	BaseStats = GemRB.GetPlayerStats (pc, 1)
 
 	# Setting up the character information
 	GetCharacterHeader (pc)
@@ -168,39 +170,39 @@ def UpdateRecordsWindow (Window):
 
 	# armorclass
 	Label = Window.GetControl (0x1000000b)
-	Label.SetText (str (GemRB.GetPlayerStat (pc, IE_ARMORCLASS)))
+	Label.SetText (str (Stats[IE_ARMORCLASS]))
 	Label.SetTooltip (4197)
 
 	# hp now
 	Label = Window.GetControl (0x1000000c)
-	Label.SetText (str (GemRB.GetPlayerStat (pc, IE_HITPOINTS)))
+	Label.SetText (str (Stats[IE_HITPOINTS]))
 	Label.SetTooltip (4198)
 
 	# hp max
 	Label = Window.GetControl (0x1000000d)
-	Label.SetText (str (GemRB.GetPlayerStat (pc, IE_MAXHITPOINTS)))
+	Label.SetText (str (Stats[IE_MAXHITPOINTS]))
 	Label.SetTooltip (4199)
 
 	# stats
 
-	sstr = GemRB.GetPlayerStat (pc, IE_STR)
-	bstr = GemRB.GetPlayerStat (pc, IE_STR,1)
-	sstrx = GemRB.GetPlayerStat (pc, IE_STREXTRA)
-	bstrx = GemRB.GetPlayerStat (pc, IE_STREXTRA,1)
+	sstr = Stats[IE_STR]
+	bstr = BaseStats[IE_STR]
+	sstrx = Stats[IE_STREXTRA]
+	bstrx = BaseStats[IE_STREXTRA]
 	if (sstrx > 0) and (sstr==18):
 		sstr = "%d/%02d" %(sstr, sstrx % 100)
 	if (bstrx > 0) and (bstr==18):
 		bstr = "%d/%02d" %(bstr, bstrx % 100)
-	sint = GemRB.GetPlayerStat (pc, IE_INT)
-	bint = GemRB.GetPlayerStat (pc, IE_INT,1)
-	swis = GemRB.GetPlayerStat (pc, IE_WIS)
-	bwis = GemRB.GetPlayerStat (pc, IE_WIS,1)
-	sdex = GemRB.GetPlayerStat (pc, IE_DEX)
-	bdex = GemRB.GetPlayerStat (pc, IE_DEX,1)
-	scon = GemRB.GetPlayerStat (pc, IE_CON)
-	bcon = GemRB.GetPlayerStat (pc, IE_CON,1)
-	schr = GemRB.GetPlayerStat (pc, IE_CHR)
-	bchr = GemRB.GetPlayerStat (pc, IE_CHR,1)
+	sint = Stats[IE_INT]
+	bint = BaseStats[IE_INT]
+	swis = Stats[IE_WIS]
+	bwis = BaseStats[IE_WIS]
+	sdex = Stats[IE_DEX]
+	bdex = BaseStats[IE_DEX]
+	scon = Stats[IE_CON]
+	bcon = BaseStats[IE_CON]
+	schr = Stats[IE_CHR]
+	bchr = BaseStats[IE_CHR]
 
 	stats = (sstr, sint, swis, sdex, scon, schr)
 	basestats = (bstr, bint, bwis, bdex, bcon, bchr)
@@ -214,9 +216,9 @@ def UpdateRecordsWindow (Window):
 
 	# race
 	# HACK: for some strange reason, Morte's race is 1 (Human), instead of 45 (Morte)
-	print "species: %d  race: %d" %(GemRB.GetPlayerStat (pc, IE_SPECIES), GemRB.GetPlayerStat (pc, IE_RACE))
+	print "species: %d  race: %d" %(Stats[IE_SPECIES], Stats[IE_RACE])
 	#be careful, some saves got this field corrupted
-	race = GemRB.GetPlayerStat (pc, IE_SPECIES) - 1
+	race = Stats[IE_SPECIES] - 1
 
 	text = CommonTables.Races.GetValue (race, 0)
 
@@ -226,7 +228,7 @@ def UpdateRecordsWindow (Window):
 
 	# sex
 	GenderTable = GemRB.LoadTable ("GENDERS")
-	text = GenderTable.GetValue (GemRB.GetPlayerStat (pc, IE_SEX) - 1, GTV_STR)
+	text = GenderTable.GetValue (Stats[IE_SEX] - 1, GTV_STR)
 
 	Label = Window.GetControl (0x10000015)
 	Label.SetText (text)
@@ -239,7 +241,7 @@ def UpdateRecordsWindow (Window):
 	Label.SetText (text)
 
 	# alignment
-	align = GemRB.GetPlayerStat (pc, IE_ALIGNMENT)
+	align = Stats[IE_ALIGNMENT]
 	ss = GemRB.LoadSymbol ("ALIGN")
 	sym = ss.GetValue (align)
 
@@ -255,7 +257,7 @@ def UpdateRecordsWindow (Window):
 
 
 	# faction
-	faction = GemRB.GetPlayerStat (pc, IE_FACTION)
+	faction = Stats[IE_FACTION]
 	FactionTable = GemRB.LoadTable ("FACTIONS")
 	faction_help = FactionTable.GetValue (faction, 0, GTV_REF)
 	frame = FactionTable.GetValue (faction, 1)
@@ -394,11 +396,12 @@ def OnRecordsHelpCharisma ():
 	return
 
 def GetCharacterHeader (pc):
+	Stats = GemRB.GetPlayerStats (pc)
 	global avatar_header
 
-	Class = GemRB.GetPlayerStat (pc, IE_CLASS) - 1
+	Class = Stats[IE_CLASS] - 1
 	Multi = GUICommon.HasMultiClassBits (pc)
-	Specific = "%d"%GemRB.GetPlayerStat (pc, IE_SPECIFIC)
+	Specific = "%d"%Stats[IE_SPECIFIC]
 
 	#Nameless is Specific == 1
 	avatar_header['Specific'] = Specific
@@ -411,24 +414,24 @@ def GetCharacterHeader (pc):
 		avatar_header['SecoLevel'] = 0
 
 		if avatar_header['PrimClass'] == "FIGHTER":
-			avatar_header['PrimLevel'] = GemRB.GetPlayerStat (pc, IE_LEVEL)
-			avatar_header['XP'] = GemRB.GetPlayerStat (pc, IE_XP)
+			avatar_header['PrimLevel'] = Stats[IE_LEVEL]
+			avatar_header['XP'] = Stats[IE_XP]
 		elif avatar_header['PrimClass'] == "MAGE":
-			avatar_header['PrimLevel'] = GemRB.GetPlayerStat (pc, IE_LEVEL2)
-			avatar_header['XP'] = GemRB.GetPlayerStat (pc, IE_XP_MAGE)
+			avatar_header['PrimLevel'] = Stats[IE_LEVEL2]
+			avatar_header['XP'] = Stats[IE_XP_MAGE]
 		else:
-			avatar_header['PrimLevel'] = GemRB.GetPlayerStat (pc, IE_LEVEL3)
-			avatar_header['XP'] = GemRB.GetPlayerStat (pc, IE_XP_THIEF)
+			avatar_header['PrimLevel'] = Stats[IE_LEVEL3]
+			avatar_header['XP'] = Stats[IE_XP_THIEF]
 
 		avatar_header['PrimNextLevXP'] = GetNextLevelExp (avatar_header['PrimLevel'], avatar_header['PrimClass'])
 		avatar_header['SecoNextLevXP'] = 0
 	else:
 		# PC is not NAMELESS_ONE
-		avatar_header['PrimLevel'] = GemRB.GetPlayerStat (pc, IE_LEVEL)
-		avatar_header['XP'] = GemRB.GetPlayerStat (pc, IE_XP)
+		avatar_header['PrimLevel'] = Stats[IE_LEVEL]
+		avatar_header['XP'] = Stats[IE_XP]
 		if Multi:
 			avatar_header['XP'] = avatar_header['XP'] / 2
-			avatar_header['SecoLevel'] = GemRB.GetPlayerStat (pc, IE_LEVEL2)
+			avatar_header['SecoLevel'] = Stats[IE_LEVEL2]
 
 			avatar_header['PrimClass'] = "FIGHTER"
 			if Multi == 3:
@@ -474,7 +477,8 @@ def GetStatOverview (pc):
 	woff = "[/color]"
 	str_None = GemRB.GetString (41275)
 
-	GS = lambda s, pc=pc: GemRB.GetPlayerStat (pc, s)
+	Stats = GemRB.GetPlayerStats (pc)
+	GS = lambda s: Stats[s]
 
 	stats = []
 
@@ -24,6 +24,7 @@
 
 #include "Interface.h"
 #include "Sprite2D.h"
+#include "Video.h"
 
 namespace GemRB {
 
@@ -39,6 +40,10 @@ AnimationFactory::~AnimationFactory(void)
 	for (unsigned int i = 0; i < frames.size(); i++) {
 		frames[i]->release();
 	}
+	std::map<std::pair<unsigned short, unsigned int>, Sprite2D*>::iterator it;
+	for (it = mirroredFrames.begin(); it != mirroredFrames.end(); ++it) {
+		it->second->release();
+	}
 	if (FLTable)
 		free( FLTable);
 
@@ -72,18 +77,36 @@ void AnimationFactory::SetFrameData(unsigned char* FrameData)
 }
 
 
-Animation* AnimationFactory::GetCycle(unsigned char cycle)
+Sprite2D* AnimationFactory::GetMirroredFrame(unsigned short index, unsigned int mirror)
+{
+	std::pair<unsigned short, unsigned int> key(index, mirror);
+	std::map<std::pair<unsigned short, unsigned int>, Sprite2D*>::iterator it = mirroredFrames.find(key);
+	if (it != mirroredFrames.end()) {
+		return it->second;
+	}
+	Sprite2D* spr = core->GetVideoDriver()->MirrorSprite(frames[index], mirror, true);
+	mirroredFrames[key] = spr;
+	return spr;
+}
+
+Animation* AnimationFactory::GetCycle(unsigned char cycle, unsigned int mirror)
 {
 	if (cycle >= cycles.size()) {
 		return NULL;
 	}
+	mirror &= BLIT_MIRRORX|BLIT_MIRRORY;
 	int ff = cycles[cycle].FirstFrame;
 	int lf = ff + cycles[cycle].FramesCount;
 	Animation* anim = new Animation( cycles[cycle].FramesCount );
 	int c = 0;
 	for (int i = ff; i < lf; i++) {
-		frames[FLTable[i]]->acquire();
-		anim->AddFrame( frames[FLTable[i]], c++ );
+		Sprite2D* frame = frames[FLTable[i]];
+		if (mirror) {
+			// the anchor is flipped too, so the animation area comes out mirrored
+			frame = GetMirroredFrame(FLTable[i], mirror);
+		}
+		frame->acquire();
+		anim->AddFrame( frame, c++ );
 	}
 	return anim;
 }
@@ -28,6 +28,8 @@
 #include "AnimStructures.h"
 #include "FactoryObject.h"
 
+#include <map>
+
 namespace GemRB {
 
 class GEM_EXPORT AnimationFactory : public FactoryObject {
@@ -36,6 +38,10 @@ private:
 	std::vector< CycleEntry> cycles;
 	unsigned short* FLTable;	// Frame Lookup Table
 	unsigned char* FrameData;
+	// mirrored copies of the frames, made on demand and shared by all animations
+	std::map<std::pair<unsigned short, unsigned int>, Sprite2D*> mirroredFrames;
+
+	Sprite2D* GetMirroredFrame(unsigned short index, unsigned int mirror);
 
 public:
 	AnimationFactory(const char* ResRef);
@@ -44,7 +50,9 @@ public:
 	void AddCycle(CycleEntry cycle);
 	void LoadFLT(unsigned short* buffer, int count);
 	void SetFrameData(unsigned char* FrameData);
-	Animation* GetCycle(unsigned char cycle);
+	/** mirror can be BLIT_MIRRORX and/or BLIT_MIRRORY, which is cheaper than
+	 * mirroring the returned animation, since the flipped frames are shared */
+	Animation* GetCycle(unsigned char cycle, unsigned int mirror = 0);
 	/** No descriptions */
 	Sprite2D* GetFrame(unsigned short index, unsigned char cycle=0) const;
 	Sprite2D* GetFrameWithoutCycle(unsigned short index) const;
@@ -34,7 +34,11 @@ public:
 	virtual int CreateArchive(DataStream *stream) = 0;
 	//decompressing a .sav file similar to CBF
 	virtual int DecompressSaveGame(DataStream *compressed) = 0;
+	//remembering the members of a freshly written .sav, so unchanged ones can be reused
+	virtual int ReindexSaveGame(DataStream *compressed) = 0;
 	virtual int AddToSaveGame(DataStream *str, DataStream *uncompressed) = 0;
+	//adding an already compressed member, copied verbatim
+	virtual int AddCompressedToSaveGame(DataStream *str, const char *fname, ieDword declen, DataStream *compressed, ieDword complen) = 0;
 };
 
 }
@@ -79,6 +79,8 @@ public:
 	virtual void QueueBuffer(int stream, unsigned short bits,
 				int channels, short* memory, int size, int samplerate) = 0;
 	virtual void UpdateMapAmbient(MapReverb&) {};
+	// called once per frame from the main loop, for work that has to happen on the main thread
+	virtual void Update() {};
 
 protected:
 	AmbientMgr* ambim;
@@ -1076,7 +1076,31 @@ Animation** CharAnimations::GetAnimation(unsigned char Stance, unsigned char Ori
 			}
 		}
 
-		Animation* a = af->GetCycle( Cycle );
+		// the mirrored frames are kept by the factory and shared by all actors
+		unsigned int mirror = 0;
+		switch (GetAnimType()) {
+			case IE_ANI_NINE_FRAMES: //dragon animations
+			case IE_ANI_FOUR_FRAMES: //wyvern animations
+			case IE_ANI_FOUR_FRAMES_2:
+			case IE_ANI_BIRD:
+			case IE_ANI_CODE_MIRROR:
+			case IE_ANI_CODE_MIRROR_2: //9 orientations
+			case IE_ANI_CODE_MIRROR_3:
+			case IE_ANI_PST_ANIMATION_3: //no stc just std
+			case IE_ANI_PST_ANIMATION_2: //no std just stc
+			case IE_ANI_PST_ANIMATION_1:
+			case IE_ANI_FRAGMENT:
+			case IE_ANI_TWO_FILES_3C:
+			case IE_ANI_TWO_FILES_5:
+				if (Orient > 8) {
+					mirror = BLIT_MIRRORX;
+				}
+				break;
+			default:
+				break;
+		}
+
+		Animation* a = af->GetCycle( Cycle, mirror );
 		anims[part] = a;
 
 		if (!a) {
@@ -1155,28 +1179,6 @@ Animation** CharAnimations::GetAnimation(unsigned char Stance, unsigned char Ori
 				a->Flags |= A_ANI_PLAYONCE;
 				break;
 		}
-		switch (GetAnimType()) {
-			case IE_ANI_NINE_FRAMES: //dragon animations
-			case IE_ANI_FOUR_FRAMES: //wyvern animations
-			case IE_ANI_FOUR_FRAMES_2:
-			case IE_ANI_BIRD:
-			case IE_ANI_CODE_MIRROR:
-			case IE_ANI_CODE_MIRROR_2: //9 orientations
-			case IE_ANI_CODE_MIRROR_3:
-			case IE_ANI_PST_ANIMATION_3: //no stc just std
-			case IE_ANI_PST_ANIMATION_2: //no std just stc
-			case IE_ANI_PST_ANIMATION_1:
-			case IE_ANI_FRAGMENT:
-			case IE_ANI_TWO_FILES_3C:
-			case IE_ANI_TWO_FILES_5:
-				if (Orient > 8) {
-					a->MirrorAnimation( );
-				}
-				break;
-			default:
-				break;
-		}
-
 		// make animarea of part 0 encompass the animarea of the other parts
 		if (part > 0)
 			anims[0]->AddAnimArea(a);
@@ -37,21 +37,27 @@ Factory::~Factory(void)
 	}
 }
 
+std::pair<SClass_ID, std::string> Factory::MakeKey(const char* ResRef, SClass_ID type)
+{
+	char key[sizeof(ieResRef)];
+	strnlwrcpy(key, ResRef, sizeof(ieResRef)-1);
+	return std::make_pair(type, std::string(key));
+}
+
 void Factory::AddFactoryObject(FactoryObject* fobject)
 {
+	// like the old linear search, the first object added wins
+	index.insert(std::make_pair(MakeKey(fobject->ResRef, fobject->SuperClassID), (int) fobjects.size()));
 	fobjects.push_back( fobject );
 }
 
 int Factory::IsLoaded(const char* ResRef, SClass_ID type) const
 {
-	for (unsigned int i = 0; i < fobjects.size(); i++) {
-		if (fobjects[i]->SuperClassID == type) {
-			if (strnicmp( fobjects[i]->ResRef, ResRef, 8 ) == 0) {
-				return i;
-			}
-		}
+	FactoryIndex::const_iterator it = index.find(MakeKey(ResRef, type));
+	if (it == index.end()) {
+		return -1;
 	}
-	return -1;
+	return it->second;
 }
 
 FactoryObject* Factory::GetFactoryObject(int pos) const
@@ -64,6 +70,8 @@ void Factory::FreeObjects(void)
 	for (unsigned int i = 0; i < fobjects.size(); i++) {
 		delete( fobjects[i] );
 	}
+	fobjects.clear();
+	index.clear();
 }
 
 }
@@ -27,11 +27,19 @@
 #include "AnimationFactory.h"
 #include "FactoryObject.h"
 
+#include <map>
+#include <string>
+
 namespace GemRB {
 
 class GEM_EXPORT Factory {
 private:
 	std::vector< FactoryObject*> fobjects;
+	// lowercased resref and type to position, so lookups don't have to scan everything
+	typedef std::map<std::pair<SClass_ID, std::string>, int> FactoryIndex;
+	FactoryIndex index;
+
+	static std::pair<SClass_ID, std::string> MakeKey(const char* ResRef, SClass_ID type);
 public:
 	Factory(void);
 	~Factory(void);
@@ -18,14 +18,38 @@
 
 #include "FileCache.h"
 
+#include "ArchiveImporter.h"
 #include "Compressor.h"
 #include "Interface.h"
 #include "PluginMgr.h"
 #include "System/FileStream.h"
 #include "System/VFS.h"
 
+#include <map>
+#include <string>
+
 namespace GemRB {
 
+struct DeferredStream {
+	unsigned long offset;
+	ieDword declen;
+	ieDword complen;
+	bool unpacked;
+};
+
+typedef std::map<std::string, DeferredStream> DeferredStreamMap;
+
+static DataStream* deferredArchive = NULL;
+static DeferredStreamMap deferredStreams;
+
+static std::string DeferredName(const char* resref, const char* ext)
+{
+	char name[_MAX_PATH];
+	snprintf(name, _MAX_PATH, "%s.%s", resref, ext);
+	strlwr(name);
+	return name;
+}
+
 DataStream* CacheCompressedStream(DataStream *stream, const char* filename, int length, bool overwrite)
 {
 	if (!core->IsAvailable(PLUGIN_COMPRESSION_ZLIB)) {
@@ -54,4 +78,90 @@ DataStream* CacheCompressedStream(DataStream *stream, const char* filename, int
 	return FileStream::OpenFile(path);
 }
 
+void SetDeferredArchive(DataStream *archive)
+{
+	deferredStreams.clear();
+	delete deferredArchive;
+	deferredArchive = archive;
+}
+
+void DeferCompressedStream(const char* filename, ieDword declen, ieDword complen, bool unpacked)
+{
+	assert(deferredArchive);
+
+	char fname[_MAX_PATH];
+	ExtractFileFromPath(fname, filename);
+	strlwr(fname);
+
+	DeferredStream& member = deferredStreams[fname];
+	member.offset = deferredArchive->GetPos();
+	member.declen = declen;
+	member.complen = complen;
+	member.unpacked = unpacked;
+	deferredArchive->Seek(complen, GEM_CURRENT_POS);
+}
+
+bool UnpackDeferredStream(const char* resref, const char* ext)
+{
+	if (deferredStreams.empty() || !ext) return true;
+
+	DeferredStreamMap::iterator it = deferredStreams.find(DeferredName(resref, ext));
+	if (it == deferredStreams.end() || it->second.unpacked) return true;
+
+	DeferredStream& member = it->second;
+	deferredArchive->Seek(member.offset, GEM_STREAM_START);
+	DataStream* cached = CacheCompressedStream(deferredArchive, it->first.c_str(), member.complen, true);
+	if (!cached) {
+		Log(ERROR, "FileCache", "Failed to unpack %s.", it->first.c_str());
+		// forget it, so the failure isn't retried on every lookup
+		deferredStreams.erase(it);
+		return false;
+	}
+	delete cached;
+	// until the cached copy is replaced, the compressed one can still be reused when saving
+	member.unpacked = true;
+	return true;
+}
+
+void ForgetDeferredStream(const char* resref, const char* ext)
+{
+	if (deferredStreams.empty() || !ext) return;
+
+	deferredStreams.erase(DeferredName(resref, ext));
+}
+
+bool IsDeferredStream(const char* filename)
+{
+	if (deferredStreams.empty()) return false;
+
+	char fname[_MAX_PATH];
+	ExtractFileFromPath(fname, filename);
+	strlwr(fname);
+	return deferredStreams.find(fname) != deferredStreams.end();
+}
+
+bool IsDeferredStreamPending(const char* filename)
+{
+	if (deferredStreams.empty()) return false;
+
+	char fname[_MAX_PATH];
+	ExtractFileFromPath(fname, filename);
+	strlwr(fname);
+	DeferredStreamMap::const_iterator it = deferredStreams.find(fname);
+	return it != deferredStreams.end() && !it->second.unpacked;
+}
+
+int CopyDeferredStreams(ArchiveImporter *ai, DataStream *dest)
+{
+	DeferredStreamMap::const_iterator it = deferredStreams.begin();
+	for (; it != deferredStreams.end(); ++it) {
+		const DeferredStream& member = it->second;
+		deferredArchive->Seek(member.offset, GEM_STREAM_START);
+		if (ai->AddCompressedToSaveGame(dest, it->first.c_str(), member.declen, deferredArchive, member.complen) != GEM_OK) {
+			return GEM_ERROR;
+		}
+	}
+	return GEM_OK;
+}
+
 }
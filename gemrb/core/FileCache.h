@@ -23,8 +23,26 @@
 
 namespace GemRB {
 
+class ArchiveImporter;
+
 GEM_EXPORT DataStream* CacheCompressedStream(DataStream *stream, const char* filename, int length = 0, bool overwrite = false);
 
+// compressed members (eg. of a saved game) can also be left in the archive until they are needed
+// the archive is taken over and replaces the previous one, NULL just forgets all members
+GEM_EXPORT void SetDeferredArchive(DataStream *archive);
+// the compressed data starts at the current position of the archive
+// 'unpacked' means the cache already holds an identical copy
+GEM_EXPORT void DeferCompressedStream(const char* filename, ieDword declen, ieDword complen, bool unpacked = false);
+// unpacks the member into the cache if it is still pending, returns false on errors
+GEM_EXPORT bool UnpackDeferredStream(const char* resref, const char* ext);
+// the cached file got replaced or removed, so the archived version is obsolete
+GEM_EXPORT void ForgetDeferredStream(const char* resref, const char* ext);
+// true while the archived version is current, whether it was unpacked or not
+GEM_EXPORT bool IsDeferredStream(const char* filename);
+GEM_EXPORT bool IsDeferredStreamPending(const char* filename);
+// adds the current members to a new archive without compressing them again
+GEM_EXPORT int CopyDeferredStreams(ArchiveImporter *ai, DataStream *dest);
+
 }
 
 #endif
@@ -146,11 +146,18 @@ Font::Font(Palette* pal, ieWord lineheight, ieWord baseline)
 : palette(NULL), LineHeight(lineheight), Baseline(baseline)
 {
 	CurrentAtlasPage = NULL;
+	sizeCacheBytes = 0;
+	sizeCacheHits = sizeCacheMisses = 0;
 	SetPalette(pal);
 }
 
 Font::~Font(void)
 {
+	if (sizeCacheHits + sizeCacheMisses) {
+		Log(DEBUG, "Font", "StringSize cache: %lu hits, %lu misses, %lu entries using %lu bytes",
+			sizeCacheHits, sizeCacheMisses, (unsigned long)sizeCache.size(), (unsigned long)sizeCacheBytes);
+	}
+
 	GlyphAtlas::iterator it;
 	for (it = Atlas.begin(); it != Atlas.end(); ++it) {
 		delete *it;
@@ -622,6 +629,68 @@ size_t Font::StringSizeWidth(const String& string, size_t width, size_t* numChar
 Size Font::StringSize(const String& string, StringSizeMetrics* metrics) const
 {
 	if (!string.length()) return Size();
+
+	SizeCacheKey key;
+	// FNV-1a
+	key.hash = 2166136261UL;
+	for (size_t i = 0; i < string.length(); i++) {
+		key.hash = (key.hash ^ (unsigned long) string[i]) * 16777619UL;
+	}
+	key.w = (metrics) ? metrics->size.w : 0;
+	key.h = (metrics) ? metrics->size.h : 0;
+	key.flags = (metrics) ? (1 | (metrics->forceBreak << 1)) : 0;
+
+	SizeCache::iterator it = sizeCache.find(key);
+	if (it != sizeCache.end() && it->second.string == string) {
+		sizeCacheHits++;
+		SizeCacheEntry& entry = it->second;
+		sizeCacheLRU.splice(sizeCacheLRU.begin(), sizeCacheLRU, entry.lru);
+		if (metrics) {
+			metrics->size = entry.size;
+			metrics->numChars = entry.numChars;
+			metrics->forceBreak = entry.forceBreak;
+		}
+		return entry.size;
+	}
+	sizeCacheMisses++;
+
+	StringSizeMetrics result = {Size(), 0, false};
+	if (metrics) {
+		result = *metrics;
+	}
+	Size size = MeasureString(string, (metrics) ? &result : NULL);
+	if (metrics) {
+		*metrics = result;
+	}
+
+	size_t entrySize = sizeof(SizeCacheEntry) + string.length() * sizeof(wchar_t);
+	if (it == sizeCache.end()) {
+		it = sizeCache.insert(std::make_pair(key, SizeCacheEntry())).first;
+		sizeCacheLRU.push_front(it);
+		it->second.lru = sizeCacheLRU.begin();
+	} else {
+		// a hash collision, the old string loses its place
+		sizeCacheBytes -= sizeof(SizeCacheEntry) + it->second.string.length() * sizeof(wchar_t);
+		sizeCacheLRU.splice(sizeCacheLRU.begin(), sizeCacheLRU, it->second.lru);
+	}
+	SizeCacheEntry& entry = it->second;
+	entry.string = string;
+	entry.size = size;
+	entry.numChars = result.numChars;
+	entry.forceBreak = result.forceBreak;
+	sizeCacheBytes += entrySize;
+
+	while (sizeCacheBytes > FONT_SIZE_CACHE_SIZE && sizeCacheLRU.size() > 1) {
+		SizeCache::iterator last = sizeCacheLRU.back();
+		sizeCacheBytes -= sizeof(SizeCacheEntry) + last->second.string.length() * sizeof(wchar_t);
+		sizeCacheLRU.pop_back();
+		sizeCache.erase(last);
+	}
+	return size;
+}
+
+Size Font::MeasureString(const String& string, StringSizeMetrics* metrics) const
+{
 #define WILL_WRAP(val) \
 	(stop && stop->w && lineW + val > stop->w)
 
@@ -38,6 +38,7 @@
 #include "SpriteSheet.h"
 
 #include <deque>
+#include <list>
 #include <map>
 
 namespace GemRB {
@@ -62,6 +63,9 @@ class Palette;
 // work around to use the region passed to Font::Print as if it were the actual print size when the text cant actually fit the region
 #define IE_FONT_NO_CALC		 0x80
 
+// memory budget (per font) for remembered StringSize results
+#define FONT_SIZE_CACHE_SIZE (256*1024)
+
 struct Glyph {
 	const Size size;
 	const Point pos;
@@ -151,6 +155,36 @@ private:
 	GlyphIndex AtlasIndex;
 	GlyphAtlas Atlas;
 
+	// StringSize is called for every line and word each time text is drawn,
+	// so remember the results instead of measuring static text glyph by glyph every frame
+	struct SizeCacheKey {
+		unsigned long hash;
+		int w, h; // the size limit
+		int flags; // whether metrics were given and forceBreak was allowed
+
+		bool operator<(const SizeCacheKey& rhs) const {
+			if (hash != rhs.hash) return hash < rhs.hash;
+			if (w != rhs.w) return w < rhs.w;
+			if (h != rhs.h) return h < rhs.h;
+			return flags < rhs.flags;
+		}
+	};
+	struct SizeCacheEntry;
+	typedef std::map<SizeCacheKey, SizeCacheEntry> SizeCache;
+	typedef std::list<SizeCache::iterator> SizeCacheLRU;
+	struct SizeCacheEntry {
+		String string; // to rule out hash collisions
+		Size size;
+		size_t numChars;
+		bool forceBreak;
+		SizeCacheLRU::iterator lru;
+	};
+
+	mutable SizeCache sizeCache;
+	mutable SizeCacheLRU sizeCacheLRU; // most recently used at the front
+	mutable size_t sizeCacheBytes;
+	mutable unsigned long sizeCacheHits, sizeCacheMisses;
+
 protected:
 	mutable Palette* palette;
 
@@ -207,6 +241,10 @@ public:
 
 	// like StringSize, but single line and doens't take whitespace into consideration
 	size_t StringSizeWidth(const String&, size_t width, size_t* numChars = NULL) const;
+
+private:
+	// the uncached StringSize
+	Size MeasureString(const String&, StringSizeMetrics* metrics) const;
 };
 
 }
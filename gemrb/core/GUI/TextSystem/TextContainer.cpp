@@ -310,11 +310,10 @@ void ContentContainer::DrawSelf(Region drawFrame, const Region& clip)
 	if (layout.empty()) return;
 	Point dp = drawFrame.Origin() + Point(margin.left, margin.top);
 	
-	Region sc = video->GetScreenClip();
-	sc.x += margin.left;
-	sc.y += margin.top;
-	sc.w -= margin.left + margin.right;
-	sc.h -= margin.top + margin.bottom;
+	// the clip may only be a dirty portion of the view, so intersect rather than shrink it
+	Region contentFrame(dp, Size(drawFrame.w - margin.left - margin.right, drawFrame.h - margin.top - margin.bottom));
+	Region sc = video->GetScreenClip().Intersect(contentFrame);
+	if (sc.Dimensions().IsEmpty()) return;
 	video->SetScreenClip(&sc);
 
 	ContentLayout::const_iterator it = layout.begin();
@@ -328,6 +327,13 @@ void ContentContainer::DrawSelf(Region drawFrame, const Region& clip)
 
 void ContentContainer::DrawContents(const Layout& layout, const Point& point)
 {
+	// long histories are mostly scrolled out of view, so only draw what is visible
+	Region bounds = layout.bounds;
+	bounds.x += point.x;
+	bounds.y += point.y;
+	if (!bounds.IntersectsRegion(core->GetVideoDriver()->GetScreenClip())) {
+		return;
+	}
 	layout.content->DrawContentsInRegions(layout.regions, point);
 }
 
@@ -347,7 +353,12 @@ void ContentContainer::InsertContentAfter(Content* newContent, const Content* ex
 		LayoutContentsFrom(contents.begin());
 	} else {
 		ContentList::iterator it;
-		it = std::find(contents.begin(), contents.end(), existing);
+		if (existing == contents.back()) {
+			// appending, no need to search
+			it = --contents.end();
+		} else {
+			it = std::find(contents.begin(), contents.end(), existing);
+		}
 		contents.insert(++it, newContent);
 		LayoutContentsFrom(--it);
 	}
@@ -391,9 +402,12 @@ Content* ContentContainer::RemoveContent(const Content* span, bool doLayout)
 		Content* content = *it;
 		it = contents.erase(it);
 		content->parent = NULL;
-		layout.erase(std::find(layout.begin(), layout.end(), content));
+		ContentLayout::iterator lit = FindLayout(content);
+		if (lit != layout.end()) {
+			RewindLayoutPoint(lit->origin);
+			layout.erase(lit);
+		}
 
-		layoutPoint = Point(); // reset cached layoutPoint
 		if (doLayout) {
 			LayoutContentsFrom(it);
 		}
@@ -409,8 +423,11 @@ ContentContainer::EraseContent(ContentList::iterator it)
 {
 	Content* content = *it;
 	content->parent = NULL;
-	layout.erase(std::find(layout.begin(), layout.end(), content));
-	layoutPoint = Point(); // reset cached layoutPoint
+	ContentLayout::iterator lit = FindLayout(content);
+	if (lit != layout.end()) {
+		RewindLayoutPoint(lit->origin);
+		layout.erase(lit);
+	}
 	ContentRemoved(content);
 	delete content;
 
@@ -475,7 +492,7 @@ Region ContentContainer::BoundingBoxForContent(const Content* c) const
 
 const ContentContainer::Layout& ContentContainer::LayoutForContent(const Content* c) const
 {
-	ContentLayout::const_iterator it = std::find(layout.begin(), layout.end(), c);
+	ContentLayout::const_iterator it = FindLayout(c);
 	if (it != layout.end()) {
 		return *it;
 	}
@@ -483,10 +500,36 @@ const ContentContainer::Layout& ContentContainer::LayoutForContent(const Content
 	return NullLayout;
 }
 
+// layout is mostly looked up for the most recently added content, so search from the back
+ContentContainer::ContentLayout::iterator ContentContainer::FindLayout(const Content* c)
+{
+	ContentLayout::reverse_iterator it = std::find(layout.rbegin(), layout.rend(), c);
+	return (it == layout.rend()) ? layout.end() : --it.base();
+}
+
+ContentContainer::ContentLayout::const_iterator ContentContainer::FindLayout(const Content* c) const
+{
+	ContentLayout::const_reverse_iterator it = std::find(layout.rbegin(), layout.rend(), c);
+	return (it == layout.rend()) ? layout.end() : --it.base();
+}
+
+// the layout point only ever advances ltr-ttb, so when content is removed or relaid
+// the next layout can resume from where the earliest of them was placed instead of starting over
+void ContentContainer::RewindLayoutPoint(const Point& p)
+{
+	if (p.y < layoutPoint.y || (p.y == layoutPoint.y && p.x < layoutPoint.x)) {
+		layoutPoint = p;
+	}
+}
+
 const Region* ContentContainer::ContentRegionForRect(const Region& r) const
 {
-	ContentLayout::const_iterator it = layout.begin();
+	// nothing before the first layout reaching below r.y can intersect
+	ContentLayout::const_iterator it = std::upper_bound(layout.begin(), layout.end(), r.y, Layout::ReachesBelow);
 	for (; it != layout.end(); ++it) {
+		if (!it->bounds.IntersectsRegion(r)) {
+			continue;
+		}
 		const Regions& rgns = it->regions;
 		Regions::const_iterator rit = rgns.begin();
 		for (; rit != rgns.end(); ++rit) {
@@ -521,9 +564,9 @@ void ContentContainer::LayoutContentsFrom(ContentList::const_iterator it)
 	// clear the existing layout, but only for "it" and onward
 	ContentList::const_iterator clearit = it;
 	for (; clearit != contents.end(); ++clearit) {
-		ContentLayout::iterator i = std::find(layout.begin(), layout.end(), *clearit);
+		ContentLayout::iterator i = FindLayout(*clearit);
 		if (i != layout.end()) {
-			layoutPoint = Point(); // reset cached layoutPoint
+			RewindLayoutPoint(i->origin);
 			// since 'layout' is sorted alongsize 'contents' we should be able clear everyting following 'i' and bail
 			layout.erase(i, layout.end());
 			break;
@@ -568,7 +611,13 @@ void ContentContainer::LayoutContentsFrom(ContentList::const_iterator it)
 			assert(exContent != content);
 		}
 		const Regions& rgns = content->LayoutForPointInRegion(layoutPoint, layoutFrame);
-		layout.push_back(Layout(content, rgns));
+		Layout l(content, rgns);
+		l.origin = layoutPoint;
+		l.maxBottom = l.bounds.y + l.bounds.h;
+		if (!layout.empty() && layout.back().maxBottom > l.maxBottom) {
+			l.maxBottom = layout.back().maxBottom;
+		}
+		layout.push_back(l);
 		exContent = content;
 
 		ieDword flags = Flags();
@@ -131,14 +131,26 @@ protected:
 	struct Layout {
 		const Content* content;
 		Regions regions;
+		Region bounds; // encloses all the regions
+		Point origin; // the layout point the content was placed at
+		int maxBottom; // the lowest edge of this and all the preceding layouts
 
 		Layout(const Content* c, const Regions r)
-		: content(c), regions(r) {}
+		: content(c), regions(r), maxBottom(0) {
+			if (!regions.empty()) {
+				bounds = Region::RegionEnclosingRegions(regions);
+			}
+		}
 
 		bool operator==(const Content* c) const {
 			return c == content;
 		}
 
+		// for searching the layouts by maxBottom
+		static bool ReachesBelow(int y, const Layout& l) {
+			return y < l.maxBottom;
+		}
+
 		bool operator<(const Point& p) const {
 			const Region& r = regions.back();
 			return r.y < p.y || (r.x < p.x && r.y == p.y);
@@ -195,6 +207,9 @@ protected:
 	ContentList::iterator EraseContent(ContentList::iterator beg, ContentList::iterator end);
 
 	const Layout& LayoutForContent(const Content*) const;
+	ContentLayout::iterator FindLayout(const Content*);
+	ContentLayout::const_iterator FindLayout(const Content*) const;
+	void RewindLayoutPoint(const Point&);
 	const Layout* LayoutAtPoint(const Point& p) const;
 
 	void DrawSelf(Region drawFrame, const Region& clip);
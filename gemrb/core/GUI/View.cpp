@@ -83,23 +83,48 @@ void View::SetCursor(Sprite2D* c)
 
 // TODO: while GemRB does support nested subviews, it does not (fully) support overlapping subviews (same superview, intersecting frame)
 // expect weird things to happen with them
-// this method takes the dirty region so the framework exists, but currently this just invalidates any intersecting subviews
+// rgn is in our own coordinates; NULL invalidates the entire view
 void View::MarkDirty(const Region* rgn)
 {
-	if (dirty == false) {
+	if (dirty) return; // everything is going to be redrawn anyway
+
+	const Region bounds(Point(), Dimensions());
+	Region dirtyRgn = bounds;
+	if (rgn) {
+		dirtyRgn = rgn->Intersect(bounds);
+		if (dirtyRgn.Dimensions().IsEmpty()) return;
+	}
+
+	bool whole = (rgn == NULL || dirtyRgn == bounds);
+	if (!whole) {
+		// stop here if the area is already scheduled, this also ends the recursion
+		// between transparent subviews and their superview
+		if (!AddDirtyRect(dirtyRgn)) return;
+		// the dirty rects may have degenerated into the whole view
+		whole = dirtyRects.empty();
+	}
+	if (whole) {
 		dirty = true;
+		dirtyRects.clear();
+		dirtyRgn = bounds;
+	}
 
-		if (superView && !IsOpaque()) {
-			superView->DirtyBGRect(frame);
+	if (superView && !IsOpaque()) {
+		superView->MarkDirty(Region(ConvertPointToSuper(dirtyRgn.Origin()), dirtyRgn.Dimensions()));
+	}
+
+	std::list<View*>::iterator it;
+	for (it = subViews.begin(); it != subViews.end(); ++it) {
+		View* view = *it;
+		if (rgn == NULL) {
+			view->MarkDirty();
+			continue;
 		}
 
-		std::list<View*>::iterator it;
-		for (it = subViews.begin(); it != subViews.end(); ++it) {
-			View* view = *it;
-			if (rgn == NULL || view->frame.IntersectsRegion(*rgn)) {
-				// TODO: implement partial redraws and pass the intersection rather than invalidating the entire view
-				view->MarkDirty();
-			}
+		Region intersect = view->frame.Intersect(dirtyRgn);
+		if (!intersect.Dimensions().IsEmpty()) {
+			// we are going to draw over this part of the subview
+			view->MarkDirty(Region(view->ConvertPointFromSuper(intersect.Origin()), intersect.Dimensions()));
 		}
 	}
 }
@@ -109,6 +134,41 @@ void View::MarkDirty()
 	return MarkDirty(NULL);
 }
 
+void View::MarkDirty(const Region& rgn)
+{
+	return MarkDirty(&rgn);
+}
+
+// returns false if the rect is already covered
+// clears dirtyRects if tracking them isn't worth it anymore
+bool View::AddDirtyRect(const Region& r)
+{
+	static const size_t MAX_DIRTY_RECTS = 8;
+
+	Region merged = r;
+	Regions::iterator it = dirtyRects.begin();
+	while (it != dirtyRects.end()) {
+		if (it->RectInside(merged)) {
+			return false;
+		}
+		if (it->IntersectsRegion(merged)) {
+			// overlapping rects would be drawn twice, so replace both with their union
+			merged = Region::RegionEnclosingRegions(merged, *it);
+			dirtyRects.erase(it);
+			it = dirtyRects.begin(); // the union may now overlap rects we already checked
+			continue;
+		}
+		++it;
+	}
+
+	if (dirtyRects.size() >= MAX_DIRTY_RECTS || merged == Region(Point(), Dimensions())) {
+		dirtyRects.clear();
+	} else {
+		dirtyRects.push_back(merged);
+	}
+	return true;
+}
+
 bool View::NeedsDraw() const
 {
 	if (frame.Dimensions().IsEmpty() || (flags&Invisible)) return false;
@@ -128,27 +188,6 @@ bool View::IsVisible() const
 	return isVisible;
 }
 
-void View::DirtyBGRect(const Region& r)
-{
-	// no need to draw the parent BG for opaque views
-	if (superView && !IsOpaque()) {
-		Region rgn = frame.Intersect(Region(ConvertPointToSuper(r.Origin()), r.Dimensions()));
-		superView->DirtyBGRect(rgn);
-	}
-
-	// if we are going to draw the entire BG, no need to compute and store this
-	if (NeedsDraw())
-		return;
-
-	// do we want to intersect this too?
-	//Region bgRgn = Region(background->XPos, background->YPos, background->Width, background->Height);
-	Region clip(Point(), Dimensions());
-	Region dirty = r.Intersect(clip);
-	dirtyBGRects.push_back(dirty);
-	
-	MarkDirty(&dirty);
-}
-
 void View::DrawSubviews() const
 {
 	std::list<View*>::const_iterator it;
@@ -196,13 +235,21 @@ void View::Draw()
 		DrawBackground(NULL);
 		DrawSelf(drawFrame, intersect);
 	} else {
-		Regions::iterator it = dirtyBGRects.begin();
-		while (it != dirtyBGRects.end()) {
-			DrawBackground(&(*it++));
+		// only redraw the invalidated portions
+		// intersecting subviews were invalidated too, so they will be drawn on top again
+		Regions::const_iterator it = dirtyRects.begin();
+		for (; it != dirtyRects.end(); ++it) {
+			const Region rectClip = intersect.Intersect(Region(ConvertPointToWindow(it->Origin()), it->Dimensions()));
+			if (rectClip.Dimensions().IsEmpty()) continue;
+
+			video->SetScreenClip(&rectClip);
+			DrawBackground(&(*it));
+			DrawSelf(drawFrame, rectClip);
 		}
+		video->SetScreenClip(&intersect);
 	}
 
-	dirtyBGRects.clear();
+	dirtyRects.clear();
 
 	// always call draw on subviews because they can be dirty without us
 	DrawSubviews();
@@ -340,7 +387,7 @@ View* View::RemoveSubview(const View* view)
 	View* subView = *it;
 	assert(subView == view);
 	subViews.erase(it);
-	DirtyBGRect(subView->Frame());
+	MarkDirty(subView->Frame());
 
 	subView->superView = NULL;
 	subView->RemovedFromView(this);
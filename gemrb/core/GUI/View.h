@@ -73,10 +73,9 @@ private:
 
 	mutable bool dirty;
 
-	// TODO: we could/should generalize this
-	// MarkDirty could take a region, and more complicated views could potentially
-	// save a lot of drawing time by only drawing their dirty portions (GameControl?)
-	Regions dirtyBGRects;
+	// portions of the view (in view coordinates) that need to be redrawn
+	// only used while the view isn't entirely dirty; overlapping rects are merged
+	Regions dirtyRects;
 	
 	View* eventProxy;
 
@@ -95,14 +94,14 @@ protected:
 	unsigned short autoresizeFlags; // these flags don't produce notifications
 
 private:
-	void DirtyBGRect(const Region&);
+	bool AddDirtyRect(const Region&);
 	void DrawBackground(const Region*) const;
 	void DrawSubviews() const;
 	void MarkDirty(const Region*);
 
-	// TODO: to support partial redraws, we should change the clip parameter to a list of dirty rects
-	// that have all been clipped to the video ScreenClip
-	// subclasses can then use the list to efficiently redraw only those sections that are dirty
+	// when only parts of the view are dirty this is called once for each of them
+	// with the clip (and the video ScreenClip) restricted to the dirty rect
+	// subclasses can use the clip to skip drawing anything outside of it
 	virtual void DrawSelf(Region /*drawFrame*/, const Region& /*clip*/) {};
 
 	void AddedToWindow(Window*);
@@ -160,7 +159,10 @@ public:
 	void Draw();
 
 	void MarkDirty();
+	// invalidate only a portion of the view (in view coordinates)
+	void MarkDirty(const Region&);
 	virtual bool NeedsDraw() const;
+	bool NeedsPartialDraw() const { return !dirty && !dirtyRects.empty(); }
 
 	virtual bool IsAnimated() const { return false; }
 	virtual bool IsOpaque() const;
@@ -547,9 +547,11 @@ void WindowManager::DrawWindows() const
 			drawFrame = true;
 		}
 
-		if (win->IsDisabled() && win->NeedsDraw()) {
+		if (win->IsDisabled() && (win->NeedsDraw() || win->NeedsPartialDraw())) {
 			// Important to only draw if the window itself is dirty
 			// controls on greyed out windows shouldnt be updating anyway
+			// the shade covers the whole window, so partial redraws don't apply
+			win->MarkDirty();
 			win->Draw();
 			static const Color fill(0, 0, 0, 128);
 			Region winrgn(Point(), win->Dimensions());
@@ -44,6 +44,7 @@
 #include "VEFObject.h"
 #include "Scriptable/Actor.h"
 #include "System/FileStream.h"
+#include "System/MemoryStream.h"
 
 #include <cstdio>
 
@@ -96,6 +97,11 @@ void GameData::ClearCaches()
 		stores.erase(stores.begin());
 		delete store;
 	}
+
+	for (VVCMap::iterator it = vvcs.begin(); it != vvcs.end(); ++it) {
+		delete it->second;
+	}
+	vvcs.clear();
 }
 
 Actor *GameData::GetCreature(const char* ResRef, unsigned int PartySlot)
@@ -405,12 +411,40 @@ void GameData::FreeEffect(Effect *eff, const ieResRef name, bool free)
 
 //if the default setup doesn't fit for an animation
 //create a vvc for it!
+//returns a private copy of the vvc, which is read only once
+//this matters for mass effect spells, spawning lots of identical animations
+DataStream* GameData::GetVVCStream(const char *effect)
+{
+	char key[sizeof(ieResRef)];
+	strnlwrcpy(key, effect, sizeof(ieResRef)-1);
+
+	VVCMap::iterator it = vvcs.find(key);
+	if (it == vvcs.end()) {
+		DataStream *mem = NULL;
+		if (Exists( key, IE_VVC_CLASS_ID, true ) ) {
+			DataStream *ds = GetResource( key, IE_VVC_CLASS_ID );
+			if (ds) {
+				unsigned long size = ds->Size();
+				void *data = malloc(size);
+				ds->Read(data, size);
+				mem = new MemoryStream(ds->originalfile, data, size);
+				delete ds;
+			}
+		}
+		it = vvcs.insert(std::make_pair(std::string(key), mem)).first;
+	}
+	if (!it->second) {
+		return NULL;
+	}
+	return it->second->Clone();
+}
+
 ScriptedAnimation* GameData::GetScriptedAnimation( const char *effect, bool doublehint)
 {
 	ScriptedAnimation *ret = NULL;
 
-	if (Exists( effect, IE_VVC_CLASS_ID, true ) ) {
-		DataStream *ds = GetResource( effect, IE_VVC_CLASS_ID );
+	DataStream *ds = GetVVCStream(effect);
+	if (ds) {
 		ret = new ScriptedAnimation(ds);
 	} else {
 		AnimationFactory *af = (AnimationFactory *)
@@ -31,6 +31,7 @@
 #include "ResourceManager.h"
 
 #include <map>
+#include <string>
 #include <vector>
 
 #ifdef _MSC_VER // No SFINAE
@@ -120,6 +121,11 @@ private:
 	std::vector<Table> tables;
 	typedef std::map<const char*, Store*, iless> StoreMap;
 	StoreMap stores;
+	// the raw vvc files already looked up, NULL if the effect is a plain bam
+	typedef std::map<std::string, DataStream*> VVCMap;
+	VVCMap vvcs;
+
+	DataStream* GetVVCStream(const char *effect);
 };
 
 extern GEM_EXPORT GameData * gamedata;
@@ -43,6 +43,7 @@
 #include "EffectMgr.h"
 #include "EffectQueue.h"
 #include "Factory.h"
+#include "FileCache.h"
 #include "FontManager.h"
 #include "Game.h"
 #include "GameData.h"
@@ -183,6 +184,7 @@ Interface::Interface()
 	GemRBPath[0] = 0;
 	PluginsPath[0] = 0;
 	CachePath[0] = 0;
+	GlyphCachePath[0] = 0;
 	GemRBOverridePath[0] = 0;
 	GemRBUnhardcodedPath[0] = 0;
 	GameName[0] = 0;
@@ -966,6 +968,7 @@ void Interface::Main()
 		HandleGUIBehaviour();
 
 		GameLoop();
+		AudioDriver->Update();
 		winmgr->DrawWindows();
 		if (DrawFPS) {
 			frame++;
@@ -1333,6 +1336,11 @@ int Interface::Init(InterfaceConfig* config)
 #endif
 
 	CONFIG_PATH("SavePath", SavePath, GamePath);
+	// not in CachePath, which is emptied on startup and may not have subdirectories
+	CONFIG_PATH("GlyphCachePath", GlyphCachePath, "");
+	if (!GlyphCachePath[0]) {
+		PathJoin(GlyphCachePath, SavePath, "glyphcache", NULL);
+	}
 #undef CONFIG_STRING
 
 #define CONFIG_STRING(key, var) \
@@ -3205,6 +3213,8 @@ void Interface::LoadGame(SaveGame *sg, int ver_override)
 
 	LoadProgress(10);
 	if (!KeepCache) DelTree((const char *) CachePath, true);
+	// members of the previous save that were never unpacked
+	SetDeferredArchive(NULL);
 	LoadProgress(15);
 
 	if (sg == NULL) {
@@ -3743,6 +3753,7 @@ void Interface::RemoveFromCache(const ieResRef resref, SClass_ID ClassID)
 
 	PathJoinExt(filename, CachePath, resref, TypeExt(ClassID));
 	unlink ( filename);
+	ForgetDeferredStream(resref, TypeExt(ClassID));
 }
 
 //this function checks if the path is eligible as a cache
@@ -4513,7 +4524,8 @@ int Interface::CompressSave(const char *folder)
 	while(priority) {
 		do {
 			const char *name = dir.GetName();
-			if (SavedExtension(name)==priority) {
+			// a pending member is newer than a leftover file of the same name
+			if (SavedExtension(name)==priority && !IsDeferredStream(name)) {
 				char dtmp[_MAX_PATH];
 				dir.GetFullPath(dtmp);
 				FileStream fs;
@@ -4523,12 +4535,24 @@ int Interface::CompressSave(const char *folder)
 				ai->AddToSaveGame(&str, &fs);
 			}
 		} while (++dir);
+		//members of the loaded save that were never needed go in as they are
+		if (priority == 2 && CopyDeferredStreams(ai.get(), &str) != GEM_OK) {
+			Log(ERROR, "Interface", "Failed to copy the unmodified files into the save.");
+			return -1;
+		}
 		//reopen list for the second round
 		priority--;
 		if (priority>0) {
 			dir.Rewind();
 		}
 	}
+
+	//the next save can reuse the compressed data of everything that doesn't change till then
+	char path[_MAX_PATH];
+	strlcpy(path, str.originalfile, _MAX_PATH);
+	if (!str.Open(path) || ai->ReindexSaveGame(&str) != GEM_OK) {
+		Log(WARNING, "Interface", "Failed to index the new save, unchanged files will be compressed again.");
+	}
 	return 0;
 }
 
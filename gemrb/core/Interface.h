@@ -720,6 +720,7 @@ public:
 	char GemRBPath[_MAX_PATH];
 	char PluginsPath[_MAX_PATH];
 	char CachePath[_MAX_PATH];
+	char GlyphCachePath[_MAX_PATH]; // kept between runs, unlike CachePath
 	char GUIScriptsPath[_MAX_PATH];
 	char SavePath[_MAX_PATH];
 	char INIConfig[_MAX_PATH];
@@ -3879,9 +3879,10 @@ AreaAnimation::~AreaAnimation()
 
 Animation *AreaAnimation::GetAnimationPiece(AnimationFactory *af, int animCycle)
 {
-	Animation *anim = af->GetCycle( ( unsigned char ) animCycle );
+	unsigned int mirror = (Flags&A_ANI_MIRROR) ? BLIT_MIRRORX : 0;
+	Animation *anim = af->GetCycle( ( unsigned char ) animCycle, mirror );
 	if (!anim)
-		anim = af->GetCycle( 0 );
+		anim = af->GetCycle( 0, mirror );
 	if (!anim) {
 		print("Cannot load animation: %s", BAM);
 		return NULL;
@@ -3893,9 +3894,6 @@ Animation *AreaAnimation::GetAnimationPiece(AnimationFactory *af, int animCycle)
 	anim->Flags = Flags;
 	anim->x = Pos.x;
 	anim->y = Pos.y;
-	if (anim->Flags&A_ANI_MIRROR) {
-		anim->MirrorAnimation();
-	}
 
 	return anim;
 }
@@ -90,7 +90,8 @@ static void InitSparks()
 
 Particles::Particles(int s)
 {
-	points = (Element *) calloc(s, sizeof(Element) );
+	states = (int *) calloc(s, sizeof(int) );
+	positions = (Point *) calloc(s, sizeof(Point) );
 	/*
 	for (int i=0;i<MAX_SPARK_PHASE;i++) {
 		bitmap[i]=NULL;
@@ -112,9 +113,8 @@ Particles::Particles(int s)
 
 Particles::~Particles()
 {
-	if (points) {
-		free(points);
-	}
+	free(states);
+	free(positions);
 	/*
 	for (int i=0;i<MAX_SPARK_PHASE;i++) {
 		delete( bitmap[i]);
@@ -172,18 +172,18 @@ bool Particles::AddNew(const Point &point)
 	}
 	int i = last_insert;
 	while (i--) {
-		if (points[i].state == -1) {
-			points[i].state = st;
-			points[i].pos = point;
+		if (states[i] == -1) {
+			states[i] = st;
+			positions[i] = point;
 			last_insert = i;
 			return false;
 		}
 	}
 	i = size;
 	while (i--!=last_insert) {
-		if (points[i].state == -1) {
-			points[i].state = st;
-			points[i].pos = point;
+		if (states[i] == -1) {
+			states[i] = st;
+			positions[i] = point;
 			last_insert = i;
 			return false;
 		}
@@ -196,27 +196,35 @@ void Particles::Draw(const Region &vp)
 	Video *video=core->GetVideoDriver();
 	Game *game = core->GetGame();
 	Point p = vp.Origin();
+	// DrawPoints doesn't clip, unlike DrawPoint
+	const Region& clip = video->GetScreenClip();
 
 	if (owner) {
 		p.x-=pos.x;
 		p.y-=pos.y;
 	}
+
+	int shift;
+	switch(path) {
+	case SP_PATH_FLIT:
+	case SP_PATH_RAIN:
+		shift = 4;
+		break;
+	default:
+		shift = 0;
+		break;
+	}
+
+	for (int j = 0; j < MAX_SPARK_PHASE; j++) {
+		batches[j].clear();
+	}
+
 	int i = size;
 	while (i--) {
-		if (points[i].state == -1) {
+		if (states[i] == -1) {
 			continue;
 		}
-		int state;
-
-		switch(path) {
-		case SP_PATH_FLIT:
-		case SP_PATH_RAIN:
-			state = points[i].state>>4;
-			break;
-		default:
-			state = points[i].state;
-			break;
-		}
+		int state = states[i]>>shift;
 
 		int length; //used only for raindrops
 		if (state>=MAX_SPARK_PHASE) {
@@ -226,18 +234,8 @@ void Particles::Draw(const Region &vp)
 			state=MAX_SPARK_PHASE-state-1;
 			length=0;
 		}
-		Color clr = sparkcolors[color][state];
 		switch (type) {
 		case SP_TYPE_BITMAP:
-			/*
-			if (bitmap[state]) {
-				Sprite2D *frame = bitmap[state]->GetFrame(points[i].state&255);
-				video->BlitGameSprite(frame,
-					points[i].pos.x+screen.x,
-					points[i].pos.y+screen.y, 0, clr,
-					NULL, NULL, &screen);
-			}
-			*/
 			if (fragments) {
 				//IE_ANI_CAST stance has a simple looping animation
 				Animation** anims = fragments->GetAnimation( IE_ANI_CAST, i );
@@ -245,30 +243,40 @@ void Particles::Draw(const Region &vp)
 					Animation* anim = anims[0];
 					Sprite2D* nextFrame = anim->GetFrame(anim->GetCurrentFrame());
 
+					Color clr = sparkcolors[color][state];
 					ieDword flags = 0;
 					if (game) game->ApplyGlobalTint(clr, flags);
 
 					video->BlitGameSpriteWithPalette(nextFrame, fragments->GetPartPalette(0),
-													 points[i].pos.x - p.x, points[i].pos.y - p.y,
+													 positions[i].x - p.x, positions[i].y - p.y,
 													 flags, clr, NULL);
 				}
 			}
 			break;
 		case SP_TYPE_CIRCLE:
-			video->DrawCircle (points[i].pos - p, 2, clr);
+			video->DrawCircle (positions[i] - p, 2, sparkcolors[color][state]);
 			break;
 		case SP_TYPE_POINT:
 		default:
-			video->DrawPoint(points[i].pos - p, clr);
+			if (clip.PointInside(positions[i] - p)) {
+				batches[state].push_back(positions[i] - p);
+			}
 			break;
 		// this is more like a raindrop
 		case SP_TYPE_LINE:
 			if (length) {
-				video->DrawLine (points[i].pos - p, points[i].pos - p + Point((i&1), length), clr);
+				video->DrawLine (positions[i] - p, positions[i] - p + Point((i&1), length), sparkcolors[color][state]);
 			}
 			break;
 		}
 	}
+
+	// points of the same phase share the color, so they can be drawn together
+	for (int j = 0; j < MAX_SPARK_PHASE; j++) {
+		if (!batches[j].empty()) {
+			video->DrawPoints(batches[j], sparkcolors[color][j]);
+		}
+	}
 }
 
 void Particles::AddParticles(int count)
@@ -331,55 +339,17 @@ int Particles::Update()
 	default:
 		grow = size/10;
 	}
+	// move first, while the unused elements can still be told apart
+	MoveElements();
 	for(i=0;i<size;i++) {
-		if (points[i].state==-1) {
+		if (states[i]==-1) {
 			continue;
 		}
 		drawn=true;
-		if (!points[i].state) {
+		if (!states[i]) {
 			grow++;
 		}
-		points[i].state--;
-
-		switch (path) {
-		case SP_PATH_FALL:
-			points[i].pos.y+=3+((i>>2)&3);
-			points[i].pos.y%=pos.h;
-			break;
-		case SP_PATH_RAIN:
-			points[i].pos.x+=pos.w+(i&1);
-			points[i].pos.x%=pos.w;
-			points[i].pos.y+=3+((i>>2)&3);
-			points[i].pos.y%=pos.h;
-			break;
-		case SP_PATH_FLIT:
-			if (points[i].state<=MAX_SPARK_PHASE<<4) {
-				break;
-			}
-			points[i].pos.x+=core->Roll(1,3,pos.w-2);
-			points[i].pos.x%=pos.w;
-			points[i].pos.y+=(i&3)+1;
-			break;
-		case SP_PATH_EXPL:
-			points[i].pos.y+=1;
-			break;
-		case SP_PATH_FOUNT:
-			if (points[i].state<=MAX_SPARK_PHASE) {
-				break;
-			}
-			if (points[i].state<(MAX_SPARK_PHASE+pos.h)) {
-				if ( (points[i].state&7) == 7) {
-					points[i].pos.x+=(i&3)-1;
-				}
-				points[i].pos.y+=2;
-			} else {
-				if ( (points[i].state&7) == 7) {
-					points[i].pos.x+=(i&3)-1;
-				}
-				points[i].pos.y-=2;
-			}
-			break;
-		}
+		states[i]--;
 	}
 	if (phase==P_GROW) {
 		AddParticles(grow);
@@ -391,4 +361,59 @@ int Particles::Update()
 	return drawn;
 }
 
+void Particles::MoveElements()
+{
+	int i;
+
+	//the movement uses the state the element has after this update
+	switch (path) {
+	case SP_PATH_FALL:
+		for (i=0;i<size;i++) {
+			if (states[i]==-1) continue;
+			positions[i].y+=3+((i>>2)&3);
+			positions[i].y%=pos.h;
+		}
+		break;
+	case SP_PATH_RAIN:
+		for (i=0;i<size;i++) {
+			if (states[i]==-1) continue;
+			positions[i].x+=pos.w+(i&1);
+			positions[i].x%=pos.w;
+			positions[i].y+=3+((i>>2)&3);
+			positions[i].y%=pos.h;
+		}
+		break;
+	case SP_PATH_FLIT:
+		for (i=0;i<size;i++) {
+			if (states[i]==-1) continue;
+			if (states[i]-1<=MAX_SPARK_PHASE<<4) continue;
+			positions[i].x+=core->Roll(1,3,pos.w-2);
+			positions[i].x%=pos.w;
+			positions[i].y+=(i&3)+1;
+		}
+		break;
+	case SP_PATH_EXPL:
+		for (i=0;i<size;i++) {
+			if (states[i]==-1) continue;
+			positions[i].y+=1;
+		}
+		break;
+	case SP_PATH_FOUNT:
+		for (i=0;i<size;i++) {
+			if (states[i]==-1) continue;
+			int state = states[i]-1;
+			if (state<=MAX_SPARK_PHASE) continue;
+			if ( (state&7) == 7) {
+				positions[i].x+=(i&3)-1;
+			}
+			if (state<(MAX_SPARK_PHASE+pos.h)) {
+				positions[i].y+=2;
+			} else {
+				positions[i].y-=2;
+			}
+		}
+		break;
+	}
+}
+
 }
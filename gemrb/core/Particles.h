@@ -32,6 +32,8 @@
 
 #include "Region.h"
 
+#include <vector>
+
 namespace GemRB {
 
 class CharAnimations;
@@ -42,13 +44,6 @@ class Scriptable;
 #define P_FADE  1
 #define P_EMPTY 2
 
-// this structure holds data for a single particle element
-struct Element {
-	int state;
-	Point pos;
-	Element(): state(-1) {};
-};
-
 /**
  * @class Particles 
  * Class holding information about particles and rendering them.
@@ -119,7 +114,13 @@ public:
 	int Update();
 	int GetHeight() const { return pos.y+pos.h; }
 private:
-	Element *points;
+	void MoveElements();
+
+	//the element data is kept in parallel arrays, so the update loops stay tight
+	int *states;       //-1 for unused elements
+	Point *positions;
+	//visible points to draw, collected per spark phase
+	std::vector<Point> batches[MAX_SPARK_PHASE];
 	ieDword timetolive;
 //	ieDword target;    //could be 0, in that case target is pos
 	ieWord size;       //spark number
@@ -366,6 +366,35 @@ void Wall_Polygon::SetBaseline(const Point &a, const Point &b)
 	base1=a;
 }
 
+static bool SpanLineLess(const WallSpan& a, const WallSpan& b)
+{
+	return a.y < b.y;
+}
+
+void Wall_Polygon::ComputeSpans()
+{
+	spans.clear();
+
+	std::list<Trapezoid>::const_iterator iter;
+	for (iter = trapezoids.begin(); iter != trapezoids.end(); ++iter) {
+		const Point& a = points[iter->left_edge];
+		const Point& b = points[(iter->left_edge+1)%(count)];
+		const Point& c = points[iter->right_edge];
+		const Point& d = points[(iter->right_edge+1)%(count)];
+
+		for (int py = iter->y1; py < iter->y2; ++py) {
+			WallSpan span;
+			span.y = py;
+			span.x1 = (b.x * (py - a.y) + a.x * (b.y - py))/(b.y - a.y);
+			span.x2 = (d.x * (py - c.y) + c.x * (d.y - py))/(d.y - c.y) + 1;
+			if (span.x1 >= span.x2) continue;
+			spans.push_back(span);
+		}
+	}
+	// trapezoids may overlap vertically
+	std::stable_sort(spans.begin(), spans.end(), SpanLineLess);
+}
+
 bool Wall_Polygon::PointCovered(const Point &p) const
 {
 	if (wall_flag&WF_DISABLED)
@@ -26,6 +26,7 @@
 #include "Region.h"
 
 #include <list>
+#include <vector>
 
 namespace GemRB {
 
@@ -66,18 +67,27 @@ public:
 // door polygons are not always drawn
 #define WF_DISABLED 0x80
 
+// a rasterized row of a polygon: pixels x1 (inclusive) to x2 (exclusive) on line y
+struct WallSpan {
+	int y;
+	int x1, x2;
+};
+
 class GEM_EXPORT Wall_Polygon: public Gem_Polygon {
 public:
-	Wall_Polygon(Point *points,int count,Region *bbox) : Gem_Polygon(points,count,bbox) { wall_flag = 0; }
+	Wall_Polygon(Point *points,int count,Region *bbox) : Gem_Polygon(points,count,bbox) { wall_flag = 0; ComputeSpans(); }
 	//is the point above the baseline
 	bool PointCovered(const Point &p) const;
 	bool PointCovered(int x, int y) const;
 	ieDword GetPolygonFlag() const { return wall_flag; }
 	void SetPolygonFlag(ieDword flg) { wall_flag=flg; }
 	void SetBaseline(const Point &a, const Point &b);
+	void ComputeSpans();
 public:
 	ieDword wall_flag;
 	Point base0, base1;
+	// the polygon rasterized once, sorted by line, so covers don't have to redo it
+	std::vector<WallSpan> spans;
 };
 
 }
@@ -38,6 +38,8 @@
 
 #include <cmath>
 #include <cstdlib>
+#include <new>
+#include <vector>
 
 namespace GemRB {
 
@@ -50,6 +52,41 @@ static const ieByte SixteenToFive[MAX_ORIENT]={0,1,2,3,4,3,2,1,0,1,2,3,4,3,2,1};
 
 static ProjectileServer *server = NULL;
 
+//the number of finished projectiles whose memory is kept for reuse
+#define PROJECTILE_POOL_SIZE 64
+
+static std::vector<void*> projectilePool;
+
+void* Projectile::operator new(size_t size)
+{
+	if (size == sizeof(Projectile) && !projectilePool.empty()) {
+		void* mem = projectilePool.back();
+		projectilePool.pop_back();
+		return mem;
+	}
+	return ::operator new(size);
+}
+
+void Projectile::operator delete(void* mem, size_t size)
+{
+	if (!mem) {
+		return;
+	}
+	if (size == sizeof(Projectile) && projectilePool.size() < PROJECTILE_POOL_SIZE) {
+		projectilePool.push_back(mem);
+		return;
+	}
+	::operator delete(mem);
+}
+
+void Projectile::FreePool()
+{
+	for (size_t i = 0; i < projectilePool.size(); ++i) {
+		::operator delete(projectilePool[i]);
+	}
+	projectilePool.clear();
+}
+
 Projectile::Projectile()
 {
 	autofree = false;
@@ -132,9 +169,7 @@ void Projectile::InitExtension()
 
 void Projectile::CreateAnimations(Animation **anims, const ieResRef bamres, int Seq)
 {
-	AnimationFactory* af = ( AnimationFactory* )
-		gamedata->GetFactoryResource( bamres,
-				IE_BAM_CLASS_ID, IE_NORMAL );
+	AnimationFactory* af = server->GetAnimationFactory(bamres);
 
 	if (!af) {
 		return;
@@ -215,7 +250,7 @@ void Projectile::CreateOrientedAnimations(Animation **anims, AnimationFactory *a
 			c=Cycle;
 			break;
 		}
-		Animation* a = af->GetCycle( c );
+		Animation* a = af->GetCycle( c, (mirror ? BLIT_MIRRORX : 0) | (mirrorvert ? BLIT_MIRRORY : 0) );
 		anims[Cycle] = a;
 		if (!a) continue;
 		//animations are started at a random frame position
@@ -224,12 +259,6 @@ void Projectile::CreateOrientedAnimations(Animation **anims, AnimationFactory *a
 			a->SetPos(0);
 		}
 
-		if (mirror) {
-			a->MirrorAnimation();
-		}
-		if (mirrorvert) {
-			a->MirrorAnimationVert();
-		}
 		a->gameAnimation = true;
 	}
 }
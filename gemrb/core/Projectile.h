@@ -190,6 +190,11 @@ public:
 	~Projectile();
 	void InitExtension();
 
+	//projectiles come and go in bursts, so their memory is recycled
+	static void* operator new(size_t size);
+	static void operator delete(void* mem, size_t size);
+	static void FreePool();
+
 	ieWord Speed;
 	ieDword SFlags;
 	ieResRef SoundRes1;
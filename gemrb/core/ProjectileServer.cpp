@@ -50,6 +50,7 @@ ProjectileServer::~ProjectileServer()
 	if (explosions) {
 		delete[] explosions;
 	}
+	Projectile::FreePool();
 }
 
 Projectile *ProjectileServer::CreateDefaultProjectile(unsigned int idx)
@@ -70,6 +71,21 @@ Projectile *ProjectileServer::CreateDefaultProjectile(unsigned int idx)
 	return ReturnCopy(idx);
 }
 
+AnimationFactory *ProjectileServer::GetAnimationFactory(const ieResRef bamres)
+{
+	char key[sizeof(ieResRef)];
+	strnlwrcpy(key, bamres, sizeof(ieResRef)-1);
+
+	std::map<std::string, AnimationFactory*>::iterator it = animations.find(key);
+	if (it != animations.end()) {
+		return it->second;
+	}
+	//the factory objects live as long as gamedata, so the pointer stays valid
+	AnimationFactory* af = (AnimationFactory *) gamedata->GetFactoryResource(key, IE_BAM_CLASS_ID, IE_NORMAL);
+	animations[key] = af;
+	return af;
+}
+
 //this function can return only projectiles listed in projectl.ids
 Projectile *ProjectileServer::GetProjectileByName(const ieResRef resname)
 {
@@ -25,6 +25,9 @@
 
 #include "Projectile.h"
 
+#include <map>
+#include <string>
+
 namespace GemRB {
 
 class SymbolMgr;
@@ -78,11 +81,15 @@ public:
 	ieResRef const *GetExplosion(unsigned int idx, int type);
 	//creates an empty projectile on the fly
 	Projectile *CreateDefaultProjectile(unsigned int idx);
+	//returns the (cached) animation factory of a projectile bam
+	AnimationFactory *GetAnimationFactory(const ieResRef bamres);
 private:
 	ProjectileEntry *projectiles; //this is the list of projectiles
 	int projectilecount;
 	ExplosionEntry *explosions;   //this is the list of explosion resources
 	int explosioncount;
+	//the bams already resolved for projectiles, including missing ones
+	std::map<std::string, AnimationFactory*> animations;
 	// internal function: what is max valid projectile id?
 	unsigned int PrepareSymbols(Holder<SymbolMgr> projlist);
 	// internal function: read projectiles
@@ -20,6 +20,7 @@
 
 #include "ResourceManager.h"
 
+#include "FileCache.h"
 #include "Interface.h"
 #include "PluginMgr.h"
 #include "Resource.h"
@@ -72,6 +73,7 @@ bool ResourceManager::Exists(const char *ResRef, SClass_ID type, bool silent) co
 	if (!ResRef || ResRef[0] == '\0')
 		return false;
 	// TODO: check various caches
+	UnpackDeferredStream(ResRef, core->TypeExt(type));
 	for (size_t i = 0; i < searchPath.size(); i++) {
 		if (searchPath[i]->HasResource( ResRef, type )) {
 			return true;
@@ -91,6 +93,7 @@ bool ResourceManager::Exists(const char *ResRef, const TypeID *type, bool silent
 	// TODO: check various caches
 	const std::vector<ResourceDesc> &types = PluginMgr::Get()->GetResourceDesc(type);
 	for (size_t j = 0; j < types.size(); j++) {
+		UnpackDeferredStream(ResRef, types[j].GetExt());
 		for (size_t i = 0; i < searchPath.size(); i++) {
 			if (searchPath[i]->HasResource(ResRef, types[j])) {
 				return true;
@@ -111,6 +114,8 @@ DataStream* ResourceManager::GetResource(const char* ResRef, SClass_ID type, boo
 {
 	if (!ResRef || ResRef[0] == '\0')
 		return NULL;
+	// saved areas and stores are only unpacked into the cache on demand
+	UnpackDeferredStream(ResRef, core->TypeExt(type));
 	for (size_t i = 0; i < searchPath.size(); i++) {
 		DataStream *ds = searchPath[i]->GetResource(ResRef, type);
 		if (ds) {
@@ -137,6 +142,7 @@ Resource* ResourceManager::GetResource(const char* ResRef, const TypeID *type, b
 	}
 	const std::vector<ResourceDesc> &types = PluginMgr::Get()->GetResourceDesc(type);
 	for (size_t j = 0; j < types.size(); j++) {
+		UnpackDeferredStream(ResRef, types[j].GetExt());
 		for (size_t i = 0; i < searchPath.size(); i++) {
 			DataStream *str = searchPath[i]->GetResource(ResRef, types[j]);
 			if (!str && useCorrupt && core->UseCorruptedHack) {
@@ -27,6 +27,8 @@
 #include "ResourceManager.h"
 #include "System/VFS.h"
 
+#include <vector>
+
 namespace GemRB {
 
 class ImageMgr;
@@ -83,6 +85,9 @@ private:
 	int PortraitCount;
 	int SaveID;
 	ResourceManager manager;
+	// decoded once, the load/save windows ask again whenever a slot scrolls into view
+	mutable Holder<Sprite2D> preview;
+	mutable std::vector<Holder<Sprite2D> > portraits;
 };
 
 }
@@ -137,23 +137,44 @@ SaveGame::~SaveGame()
 
 Sprite2D* SaveGame::GetPortrait(int index) const
 {
-	if (index > PortraitCount) {
+	if (index < 0 || index > PortraitCount) {
 		return NULL;
 	}
-	char nPath[_MAX_PATH];
-	sprintf( nPath, "PORTRT%d", index );
-	ResourceHolder<ImageMgr> im(nPath, manager, true);
-	if (!im)
-		return NULL;
-	return im->GetSprite2D();
+	if (portraits.empty()) {
+		portraits.resize(PortraitCount + 1);
+	}
+	Holder<Sprite2D>& portrait = portraits[index];
+	if (!portrait) {
+		char nPath[_MAX_PATH];
+		sprintf( nPath, "PORTRT%d", index );
+		ResourceHolder<ImageMgr> im(nPath, manager, true);
+		if (!im)
+			return NULL;
+		Sprite2D* spr = im->GetSprite2D();
+		if (!spr)
+			return NULL;
+		portrait = spr;
+		Sprite2D::FreeSprite(spr);
+	}
+	// the caller gets its own reference, like a freshly decoded sprite
+	portrait->acquire();
+	return portrait.get();
 }
 
 Sprite2D* SaveGame::GetPreview() const
 {
-	ResourceHolder<ImageMgr> im(Prefix, manager, true);
-	if (!im)
-		return NULL;
-	return im->GetSprite2D();
+	if (!preview) {
+		ResourceHolder<ImageMgr> im(Prefix, manager, true);
+		if (!im)
+			return NULL;
+		Sprite2D* spr = im->GetSprite2D();
+		if (!spr)
+			return NULL;
+		preview = spr;
+		Sprite2D::FreeSprite(spr);
+	}
+	preview->acquire();
+	return preview.get();
 }
 
 DataStream* SaveGame::GetGame() const
@@ -307,13 +328,44 @@ bool SaveGameIterator::RescanSaveGames()
 	dir.SetFlags(DirectoryIterator::Directories);
 	do {
 		const char *name = dir.GetName();
-		if (IsSaveGameSlot( Path, name )) {
+		if (name[0] != '.') {
 			slots.insert(strdup(name));
 		}
 	} while (++dir);
 
+	// slots whose files didn't change since the last scan are reused as they are,
+	// along with their already parsed dates and decoded pictures
+	SlotCache oldCache;
+	oldCache.swap(slotCache);
 	for (std::set<char*,iless>::iterator i = slots.begin(); i != slots.end(); i++) {
-		save_slots.push_back(BuildSaveGame(*i));
+		char slotPath[_MAX_PATH];
+		PathJoin(slotPath, Path, *i, NULL);
+		struct stat slotStat;
+		time_t mtime = 0;
+		if (stat(slotPath, &slotStat) == 0) {
+			mtime = slotStat.st_mtime;
+		}
+		// taken before building, so a save written meanwhile is picked up next time
+		SlotFiles files;
+		if (mtime) {
+			StatSlotFiles(slotPath, files);
+		}
+
+		SlotCache::iterator cached = oldCache.find(*i);
+		Holder<SaveGame> save;
+		if (cached != oldCache.end() && mtime && cached->second.mtime == mtime
+			&& cached->second.files == files) {
+			save = cached->second.save;
+		} else if (IsSaveGameSlot( Path, *i )) {
+			save = BuildSaveGame(*i);
+		}
+		if (save) {
+			save_slots.push_back(save);
+			CachedSlot& entry = slotCache[*i];
+			entry.mtime = mtime;
+			entry.files.swap(files);
+			entry.save = save;
+		}
 		free(*i);
 	}
 
@@ -372,8 +424,33 @@ Holder<SaveGame> SaveGameIterator::BuildSaveGame(const char *slotname)
 	return sg;
 }
 
+void SaveGameIterator::StatSlotFiles(const char *slotPath, SlotFiles& files)
+{
+	DirectoryIterator dir(slotPath);
+	dir.SetFlags(DirectoryIterator::Files, true);
+	if (!dir) {
+		return;
+	}
+	do {
+		char filePath[_MAX_PATH];
+		struct stat fileStat;
+		dir.GetFullPath(filePath);
+		if (stat(filePath, &fileStat)) {
+			continue;
+		}
+		SlotFile file;
+		file.name = dir.GetName();
+		file.size = fileStat.st_size;
+		file.mtime = fileStat.st_mtime;
+		files.push_back(file);
+	} while (++dir);
+}
+
 void SaveGameIterator::PruneQuickSave(const char *folder)
 {
+	// renaming keeps the directory times, so the cache can't tell the slots apart anymore
+	slotCache.clear();
+
 	char from[_MAX_PATH+20];
 	char to[_MAX_PATH+20];
 
@@ -713,6 +790,7 @@ void SaveGameIterator::DeleteSaveGame(Holder<SaveGame> game)
 		return;
 	}
 
+	slotCache.erase(game->GetSlotName());
 	core->DelTree( game->GetPath(), false ); //remove all files from folder
 	rmdir( game->GetPath() );
 }
@@ -25,6 +25,10 @@
 
 #include "SaveGame.h"
 
+#include <ctime>
+#include <sys/types.h>
+#include <map>
+#include <string>
 #include <vector>
 
 namespace GemRB {
@@ -36,6 +40,25 @@ private:
 	typedef std::vector<Holder<SaveGame> > charlist;
 	charlist save_slots;
 
+	// a save is rewritten in place, so its files are checked and not just the directory
+	struct SlotFile {
+		std::string name;
+		off_t size;
+		time_t mtime;
+		bool operator==(const SlotFile& other) const
+		{
+			return size == other.size && mtime == other.mtime && name == other.name;
+		}
+	};
+	typedef std::vector<SlotFile> SlotFiles;
+	struct CachedSlot {
+		time_t mtime; // of the slot directory, it changes when files are added or removed
+		SlotFiles files; // what the save was built from: the .sav, .gam, previews, portraits...
+		Holder<SaveGame> save;
+	};
+	typedef std::map<std::string, CachedSlot> SlotCache;
+	SlotCache slotCache;
+
 public:
 	SaveGameIterator(void);
 	~SaveGameIterator(void);
@@ -47,6 +70,7 @@ public:
 private:
 	bool RescanSaveGames();
 	static Holder<SaveGame> BuildSaveGame(const char *slotname);
+	static void StatSlotFiles(const char *slotPath, SlotFiles& files);
 	void PruneQuickSave(const char *folder);
 };
 
@@ -119,17 +119,6 @@ void ScriptedAnimation::Override(ScriptedAnimation *templ)
 	}
 }
 
-//prepare the animation before doing anything
-void ScriptedAnimation::PrepareAnimation(Animation *anim, ieDword Transparency)
-{
-	if (Transparency&IE_VVC_MIRRORX) {
-		anim->MirrorAnimation();
-	}
-	if (Transparency&IE_VVC_MIRRORY) {
-		anim->MirrorAnimationVert();
-	}
-}
-
 /* Creating animation from BAM */
 void ScriptedAnimation::LoadAnimationFactory(AnimationFactory *af, int gettwin)
 {
@@ -193,12 +182,9 @@ void ScriptedAnimation::LoadAnimationFactory(AnimationFactory *af, int gettwin)
 			p*=MAX_ORIENT;
 		}
 
-		anims[p] = af->GetCycle( (ieByte) c );
+		anims[p] = af->GetCycle( (ieByte) c, mirror ? BLIT_MIRRORX : 0 );
 		if (anims[p]) {
 			anims[p]->pos=0;
-			if (mirror) {
-				anims[p]->MirrorAnimation();
-			}
 			anims[p]->gameAnimation=true;
 		}
 	}
@@ -303,6 +289,8 @@ ScriptedAnimation::ScriptedAnimation(DataStream* stream)
 			Log(ERROR, "ScriptedAnimation", "Failed to load animation: %s!", Anim1ResRef);
 			return;
 		}
+		//the mirrored frames are shared through the factory
+		unsigned int mirror = Transparency&(BLIT_MIRRORX|BLIT_MIRRORY);
 		//no idea about vvc phases, i think they got no endphase?
 		//they certainly got onset and hold phases
 		//the face target flag should be handled too
@@ -326,9 +314,8 @@ ScriptedAnimation::ScriptedAnimation(DataStream* stream)
 					if ( (int) af->GetCycleCount()>i) c=i;
 					break;
 				}
-				anims[p_onset] = af->GetCycle( c );
+				anims[p_onset] = af->GetCycle( c, mirror );
 				if (anims[p_onset]) {
-					PrepareAnimation(anims[p_onset], Transparency);
 					//creature anims may start at random position, vvcs always start on 0
 					anims[p_onset]->pos=0;
 					//vvcs are always paused
@@ -352,9 +339,8 @@ ScriptedAnimation::ScriptedAnimation(DataStream* stream)
 					if ((int) af->GetCycleCount()>i) c=i;
 					break;
 				}
-				anims[p_hold] = af->GetCycle( c );
+				anims[p_hold] = af->GetCycle( c, mirror );
 				if (anims[p_hold]) {
-					PrepareAnimation(anims[p_hold], Transparency);
 
 					anims[p_hold]->pos=0;
 					anims[p_hold]->gameAnimation=true;
@@ -379,9 +365,8 @@ ScriptedAnimation::ScriptedAnimation(DataStream* stream)
 					if ( (int) af->GetCycleCount()>i) c=i;
 					break;
 				}
-				anims[p_release] = af->GetCycle( ( unsigned char ) c );
+				anims[p_release] = af->GetCycle( ( unsigned char ) c, mirror );
 				if (anims[p_release]) {
-					PrepareAnimation(anims[p_release], Transparency);
 
 					anims[p_release]->pos=0;
 					anims[p_release]->gameAnimation=true;
@@ -152,7 +152,6 @@ public:
 	/* returns possible twin after altering it to become underlay */
 	ScriptedAnimation *DetachTwin();
 private:
-	void PrepareAnimation(Animation *anim, ieDword Transparency);
 	void PreparePalette();
 	bool HandlePhase(Sprite2D *&frame);
 	void GetPaletteCopy();
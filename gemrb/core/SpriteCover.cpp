@@ -23,6 +23,8 @@
 #include "Interface.h"
 #include "Video.h"
 
+#include <algorithm>
+
 namespace GemRB {
 
 SpriteCover::SpriteCover(const Point& wp, const Region& rgn, int dither)
@@ -54,6 +56,11 @@ bool SpriteCover::Covers(int x, int y, int xpos, int ypos,
 	return true;
 }
 
+static bool SpanAboveLine(const WallSpan& span, int y)
+{
+	return span.y < y;
+}
+
 // flags: 0 - never dither (full cover)
 //	1 - dither if polygon wants it
 //	2 - always dither
@@ -66,53 +73,28 @@ void SpriteCover::AddPolygon(Wall_Polygon* poly)
 	int xoff = wp.x - mask->XPos;
 	int yoff = wp.y - mask->YPos;
 
+	// the polygon is already rasterized, we only have to copy the lines we overlap
+	std::vector<WallSpan>::const_iterator iter;
+	iter = std::lower_bound(poly->spans.begin(), poly->spans.end(), yoff, SpanAboveLine);
+	if (iter == poly->spans.end() || iter->y - yoff >= mask->Height) return;
+
+	bool doDither;
+	if (dither == 1) {
+		doDither = poly->wall_flag & WF_DITHER;
+	} else {
+		doDither = dither;
+	}
+
 	unsigned char* srcdata = static_cast<unsigned char*>(mask->LockSprite());
+	for (; iter != poly->spans.end() && iter->y - yoff < mask->Height; ++iter) {
+		int lt = iter->x1 - xoff;
+		int rt = iter->x2 - xoff;
+
+		if (lt < 0) lt = 0;
+		if (rt > mask->Width) rt = mask->Width;
+		if (lt >= rt) continue; // clipped
 
-	std::list<Trapezoid>::iterator iter;
-	for (iter = poly->trapezoids.begin(); iter != poly->trapezoids.end();
-		 ++iter)
-	{
-		int y_top = iter->y1 - yoff; // inclusive
-		int y_bot = iter->y2 - yoff; // exclusive
-
-		if (y_top < 0) y_top = 0;
-		if ( y_bot > mask->Height) y_bot = mask->Height;
-		if (y_top >= y_bot) continue; // clipped
-
-		int ledge = iter->left_edge;
-		int redge = iter->right_edge;
-		Point& a = poly->points[ledge];
-		Point& b = poly->points[(ledge+1)%(poly->count)];
-		Point& c = poly->points[redge];
-		Point& d = poly->points[(redge+1)%(poly->count)];
-
-		unsigned char* line = srcdata + (y_top)*mask->Width;
-		for (int sy = y_top; sy < y_bot; ++sy) {
-			int py = sy + yoff;
-
-			// TODO: maybe use a 'real' line drawing algorithm to
-			// compute these values faster.
-
-			int lt = (b.x * (py - a.y) + a.x * (b.y - py))/(b.y - a.y);
-			int rt = (d.x * (py - c.y) + c.x * (d.y - py))/(d.y - c.y) + 1;
-
-			lt -= xoff;
-			rt -= xoff;
-
-			if (lt < 0) lt = 0;
-			if (rt > mask->Width) rt = mask->Width;
-			if (lt >= rt) { line += mask->Width; continue; } // clipped
-			bool doDither;
-
-			if (dither == 1) {
-				doDither = poly->wall_flag & WF_DITHER;
-			} else {
-				doDither = dither;
-			}
-
-			memset (line+lt, (doDither) ? 0x80 : 0xff, rt-lt);
-			line += mask->Width;
-		}
+		memset(srcdata + (iter->y - yoff) * mask->Width + lt, (doDither) ? 0x80 : 0xff, rt-lt);
 	}
 
 	mask->UnlockSprite();
@@ -70,6 +70,8 @@ public:
 	virtual StringBlock GetStringBlock(ieStrRef strref, unsigned int flags = 0) = 0;
 	virtual ieStrRef UpdateString(ieStrRef strref, const char *text) = 0;
 	virtual bool HasAltTLK() const = 0;
+	// strrefs below this are valid
+	virtual ieStrRef GetStringCount() const = 0;
 };
 
 }
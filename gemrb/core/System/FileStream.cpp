@@ -22,6 +22,7 @@
 
 #include "win32def.h"
 
+#include "FileCache.h"
 #include "Interface.h"
 
 namespace GemRB {
@@ -223,6 +224,8 @@ bool FileStream::Modify(const char* fname)
 //Creating file in the cache
 bool FileStream::Create(const char* fname, SClass_ID ClassID)
 {
+	// the cached file is replaced, so a pending copy in the loaded save must not resurface
+	ForgetDeferredStream(fname, core->TypeExt(ClassID));
 	return Create(core->CachePath, fname, ClassID);
 }
 
@@ -59,7 +59,7 @@ bool Logger::SetLogLevel(log_level level)
 
 void Logger::log(log_level level, const char* owner, const char* message, log_color color)
 {
-	if (level <= myLevel) {
+	if (WantsLevel(level)) {
 		LogInternal(level, owner, message, color);
 	}
 }
@@ -59,6 +59,7 @@ public:
 	virtual void destroy();
 
 	bool SetLogLevel(log_level);
+	bool WantsLevel(log_level level) const { return level <= myLevel; }
 	void log(log_level, const char* owner, const char* message, log_color color);
 protected:
 	virtual void LogInternal(log_level, const char*, const char*, log_color)=0;
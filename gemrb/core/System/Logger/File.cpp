@@ -29,6 +29,7 @@
 #include "Interface.h"
 
 #include <cstdio>
+#include <string>
 
 namespace GemRB {
 
@@ -41,6 +42,25 @@ FileLogger::~FileLogger()
 	delete log_file;
 }
 
+// the same layout as StdioLogger without colors, but built in a local string,
+// so messages from other threads can't get mixed into each other
+void FileLogger::LogInternal(log_level level, const char* owner, const char* message, log_color /*color*/)
+{
+	if (level < FATAL) {
+		level = FATAL;
+	}
+	std::string line = "[";
+	line += owner;
+	if (log_level_text[level][0]) {
+		line += "/";
+		line += log_level_text[level];
+	}
+	line += "]: ";
+	line += message;
+	line += "\n";
+	log_file->Write(line.c_str(), line.length());
+}
+
 void FileLogger::print(const char *message)
 {
 	log_file->Write(message, strlen(message));
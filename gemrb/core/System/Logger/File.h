@@ -30,6 +30,8 @@ public:
 	FileLogger(DataStream*);
 	virtual ~FileLogger();
 
+protected:
+	void LogInternal(log_level, const char* owner, const char* message, log_color color);
 	void print(const char* message);
 
 private:
@@ -67,9 +67,27 @@ void RemoveLogger(Logger* logger)
 	}
 }
 
+static bool LevelWanted(log_level level)
+{
+	for (size_t i = 0; i < theLogger.size(); ++i) {
+		if (theLogger[i]->WantsLevel(level)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+static void Dispatch(log_level level, const char* owner, const char* message, log_color color)
+{
+	for (size_t i = 0; i < theLogger.size(); ++i) {
+		theLogger[i]->log(level, owner, message, color);
+	}
+}
+
 static void vLog(log_level level, const char* owner, const char* message, log_color color, va_list ap)
 {
-	if (theLogger.empty())
+	// don't bother formatting messages that nobody is going to see
+	if (!LevelWanted(level))
 		return;
 
 	// Copied from System/StringBuffer.cpp
@@ -79,12 +97,21 @@ static void vLog(log_level level, const char* owner, const char* message, log_co
 	// MSVC6 has old vsnprintf that doesn't give length
 	const size_t len = 4095;
 #else
-    va_list ap_copy;
+	// most messages are short, so try to format them in one pass
+	char shortBuf[512];
+	va_list ap_copy;
 	// __va_copy should always be defined
 	// va_copy is only defined by C99 (C++11 and up)
 	__va_copy(ap_copy, ap);
-    const size_t len = vsnprintf(NULL, 0, message, ap_copy);
-    va_end(ap_copy);
+	const int ret = vsnprintf(shortBuf, sizeof(shortBuf), message, ap_copy);
+	va_end(ap_copy);
+	if (ret < 0)
+		return;
+	const size_t len = ret;
+	if (len < sizeof(shortBuf)) {
+		Dispatch(level, owner, shortBuf, color);
+		return;
+	}
 #endif
 
 #if defined(__GNUC__)
@@ -92,9 +119,7 @@ static void vLog(log_level level, const char* owner, const char* message, log_co
 #endif
 	char buf[len+1];
 	vsnprintf(buf, len + 1, message, ap);
-	for (size_t i = 0; i < theLogger.size(); ++i) {
-		theLogger[i]->log(level, owner, buf, color);
-	}
+	Dispatch(level, owner, buf, color);
 }
 
 void print(const char *message, ...)
@@ -127,9 +152,7 @@ void Log(log_level level, const char* owner, const char* message, ...)
 
 void Log(log_level level, const char* owner, StringBuffer const& buffer)
 {
-	for (size_t i = 0; i < theLogger.size(); ++i) {
-		theLogger[i]->log(level, owner, buffer.get().c_str(), WHITE);
-	}
+	Dispatch(level, owner, buffer.get().c_str(), WHITE);
 }
 
 }
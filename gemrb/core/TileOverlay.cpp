@@ -20,7 +20,7 @@
 
 #include "TileOverlay.h"
 
-//#include "Game.h" // needed only for TILE_GREY below
+#include "Game.h"
 #include "GlobalTimer.h"
 #include "Interface.h"
 #include "Video.h"
@@ -35,6 +35,9 @@ TileOverlay::TileOverlay(int Width, int Height)
 	h = Height;
 	count = 0;
 	tiles = ( Tile * * ) malloc( w * h * sizeof( Tile * ) );
+	bgBuffer = NULL;
+	bgScratch = NULL;
+	bgFlags = 0;
 }
 
 TileOverlay::~TileOverlay(void)
@@ -43,6 +46,12 @@ TileOverlay::~TileOverlay(void)
 		delete( tiles[i] );
 	}
 	free( tiles );
+
+	if (bgBuffer) {
+		Video* vid = core->GetVideoDriver();
+		vid->DestroyBuffer(bgBuffer);
+		vid->DestroyBuffer(bgScratch);
+	}
 }
 
 void TileOverlay::AddTile(Tile* tile)
@@ -50,6 +59,44 @@ void TileOverlay::AddTile(Tile* tile)
 	tiles[count++] = tile;
 }
 
+// prepares bgBuffer for drawing the viewport
+// returns true if nothing of the previous contents can be reused
+bool TileOverlay::UpdateBackground(const Region& viewport, unsigned int flags)
+{
+	Video* vid = core->GetVideoDriver();
+	Color tint = ColorWhite;
+	const Game* game = core->GetGame();
+	if (game && game->GetGlobalTint()) {
+		tint = *game->GetGlobalTint();
+	}
+
+	if (!bgBuffer || bgBuffer->Size() != viewport.Dimensions()) {
+		if (bgBuffer) {
+			vid->DestroyBuffer(bgBuffer);
+			vid->DestroyBuffer(bgScratch);
+		}
+		bgBuffer = vid->CreateBuffer(Region(Point(), viewport.Dimensions()));
+		bgScratch = vid->CreateBuffer(Region(Point(), viewport.Dimensions()));
+		drawnFrames.assign(w * h, NULL);
+	} else if (flags == bgFlags && tint == bgTint) {
+		if (viewport.Origin() != bgViewport.Origin()) {
+			// scrolled: move what is still visible and only fill in the rest
+			bgScratch->Clear();
+			vid->PushDrawingBuffer(bgScratch);
+			vid->BlitVideoBuffer(bgBuffer, bgViewport.Origin() - viewport.Origin());
+			vid->PopDrawingBuffer();
+			std::swap(bgBuffer, bgScratch);
+		}
+		return false;
+	}
+
+	// everything is drawn differently now
+	bgBuffer->Clear();
+	bgFlags = flags;
+	bgTint = tint;
+	return true;
+}
+
 void TileOverlay::Draw(const Region& viewport, std::vector< TileOverlay*> &overlays, int flags)
 {
 	// determine which tiles are visible
@@ -59,6 +106,18 @@ void TileOverlay::Draw(const Region& viewport, std::vector< TileOverlay*> &overl
 	int dy = ( std::max(viewport.y, 0) + viewport.h + 63 ) / 64;
 
 	Video* vid = core->GetVideoDriver();
+	// the screen clip is in window coordinates, so it doesn't apply to our buffers
+	const Region clip = vid->GetScreenClip();
+	vid->SetScreenClip(NULL);
+	bool redrawAll = UpdateBackground(viewport, (unsigned int) flags);
+	const Region oldViewport = bgViewport;
+	bgViewport = viewport;
+
+	// the base tiles don't overlap and can be handed to the driver as a whole layer
+	// only those that changed since the last frame or were (partly) offscreen are blitted again
+	// the overlays share their sprites between cells, so they are blitted one by one afterwards
+	std::vector<TileBlit> layer;
+	std::vector<TileBlit> overlayBlits;
 	for (int y = sy; y < dy && y < h; y++) {
 		for (int x = sx; x < dx && x < w; x++) {
 			Tile* tile = tiles[( y* w ) + x];
@@ -69,8 +128,14 @@ void TileOverlay::Draw(const Region& viewport, std::vector< TileOverlay*> &overl
 				anim = tile->anim[0];
 			}
 			assert(anim);
-			vid->BlitTile( anim->NextFrame(), 0, ( x * 64 ) - viewport.x,
-						  ( y * 64 ) - viewport.y, NULL, flags );
+			const Sprite2D* frame = anim->NextFrame();
+			const Region cell(x * 64, y * 64, 64, 64);
+			if (redrawAll || drawnFrames[( y* w ) + x] != frame
+				|| !oldViewport.RectInside(cell.Intersect(viewport))) {
+				drawnFrames[( y* w ) + x] = frame;
+				layer.push_back(TileBlit(frame, 0, ( x * 64 ) - viewport.x,
+							  ( y * 64 ) - viewport.y, flags));
+			}
 			if (!tile->om || tile->tileIndex) {
 				continue;
 			}
@@ -83,20 +148,20 @@ void TileOverlay::Draw(const Region& viewport, std::vector< TileOverlay*> &overl
 					Tile *ovtile = ov->tiles[0]; //allow only 1x1 tiles now
 					if (tile->om & mask) {
 						if (RedrawTile) {
-							vid->BlitTile( ovtile->anim[0]->NextFrame(),
-						                   tile->anim[0]->NextFrame(),
-							               ( x * 64 ) - viewport.x,
-							               ( y * 64 ) - viewport.y,
-							               NULL, flags );
+							overlayBlits.push_back(TileBlit(ovtile->anim[0]->NextFrame(),
+										   tile->anim[0]->NextFrame(),
+										   ( x * 64 ) - viewport.x,
+										   ( y * 64 ) - viewport.y,
+										   flags));
 						} else {
 							Sprite2D* mask = 0;
 							if (tile->anim[1]) {
 								mask = tile->anim[1]->NextFrame();
-								vid->BlitTile( ovtile->anim[0]->NextFrame(),
+								overlayBlits.push_back(TileBlit(ovtile->anim[0]->NextFrame(),
 											   mask,
 											   ( x * 64 ) - viewport.x,
 											   ( y * 64 ) - viewport.y,
-											   NULL, BLIT_HALFTRANS | flags );
+											   BLIT_HALFTRANS | flags));
 							}
 						}
 					}
@@ -105,6 +170,22 @@ void TileOverlay::Draw(const Region& viewport, std::vector< TileOverlay*> &overl
 			}
 		}
 	}
+
+	std::vector<TileBlit>::const_iterator it = layer.begin();
+	vid->PushDrawingBuffer(bgBuffer);
+	// tiles may have transparent pixels, don't let the old contents show through
+	for (; it != layer.end(); ++it) {
+		vid->DrawRect(Region(it->x, it->y, 64, 64), ColorBlack, true);
+	}
+	vid->BlitTiles(layer);
+	vid->PopDrawingBuffer();
+	vid->SetScreenClip(&clip);
+
+	vid->BlitVideoBuffer(bgBuffer, Point());
+	it = overlayBlits.begin();
+	for (; it != overlayBlits.end(); ++it) {
+		vid->BlitTile(it->spr, it->mask, it->x, it->y, NULL, it->flags);
+	}
 }
 
 }
@@ -29,6 +29,8 @@
 
 namespace GemRB {
 
+class VideoBuffer;
+
 extern bool RedrawTile;
 
 class GEM_EXPORT TileOverlay {
@@ -37,11 +39,21 @@ public:
 	//std::vector<Tile*> tiles;
 	Tile** tiles;
 	int count;
+private:
+	// the base layer of the last drawn viewport, so unchanged tiles don't have to be blitted again
+	VideoBuffer* bgBuffer;
+	VideoBuffer* bgScratch; // the previous contents are shifted into this one when scrolling
+	Region bgViewport;
+	unsigned int bgFlags;
+	Color bgTint;
+	std::vector<const Sprite2D*> drawnFrames; // per tile, what bgBuffer currently shows
 public:
 	TileOverlay(int Width, int Height);
 	~TileOverlay(void);
 	void AddTile(Tile* tile);
 	void Draw(const Region& viewport, std::vector< TileOverlay*> &overlays, int flags);
+private:
+	bool UpdateBackground(const Region& viewport, unsigned int flags);
 };
 
 }
@@ -225,6 +225,14 @@ void Video::BlitSprite(const Sprite2D* spr, int x, int y,
 	BlitSprite(spr, src, fClip);
 }
 
+void Video::BlitTiles(const std::vector<TileBlit>& tiles)
+{
+	std::vector<TileBlit>::const_iterator it = tiles.begin();
+	for (; it != tiles.end(); ++it) {
+		BlitTile(it->spr, it->mask, it->x, it->y, NULL, it->flags);
+	}
+}
+
 void Video::BlitTiled(Region rgn, const Sprite2D* img)
 {
 	int xrep = ( rgn.w + img->Width - 1 ) / img->Width;
@@ -60,6 +60,17 @@ enum SpriteBlitFlags {
 	// Note: bits 29,30,31 are used by SDLVideo internally
 };
 
+// a single tile of a layer passed to Video::BlitTiles
+struct TileBlit {
+	const Sprite2D* spr;
+	const Sprite2D* mask;
+	int x, y;
+	unsigned int flags;
+
+	TileBlit(const Sprite2D* spr, const Sprite2D* mask, int x, int y, unsigned int flags)
+	: spr(spr), mask(mask), x(x), y(y), flags(flags) {}
+};
+
 // !!! Keep this synchronized with GUIDefines.py !!!
 // used for calculating the tooltip delay limit and the real tooltip delay
 #define TOOLTIP_DELAY_FACTOR 250
@@ -173,6 +184,12 @@ public:
 
 	virtual void BlitTile(const Sprite2D* spr, const Sprite2D* mask, int x, int y,
 						  const Region* clip, unsigned int flags) = 0;
+	/** Blits a layer of non overlapping tiles, ordered in rows from top to bottom.
+	 * No sprite may appear twice, so drivers are free to blit them in parallel;
+	 * either way everything is drawn by the time this returns. */
+	virtual void BlitTiles(const std::vector<TileBlit>& tiles);
+	/** Draws the contents of another buffer onto the drawing buffer, replacing what was there */
+	virtual void BlitVideoBuffer(VideoBuffer* buf, const Point& p) = 0;
 	void BlitSprite(const Sprite2D* spr, int x, int y,
 					const Region* clip = NULL);
 	virtual void BlitSprite(const Sprite2D* spr, const Region& src, Region dst) = 0;
@@ -32,6 +32,14 @@ struct Color {
 	Color(unsigned char r, unsigned char g, unsigned char b, unsigned char a)
 	: r(r), g(g), b(b), a(a) {}
 
+	bool operator==(const Color& rhs) const {
+		return r == rhs.r && g == rhs.g && b == rhs.b && a == rhs.a;
+	}
+
+	bool operator!=(const Color& rhs) const {
+		return !(*this == rhs);
+	}
+
 	static void MultiplyTint(Color& tint, const Color* tintMod) {
 		tint.r = (tint.r * tintMod->r) >> 8;
 		tint.g = (tint.g * tintMod->g) >> 8;
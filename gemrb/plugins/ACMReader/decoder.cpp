@@ -22,6 +22,66 @@
 
 #include <cstdlib>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// The carry memory of each level is kept planar (all first values, then all
+// second values), so the carries of neighbouring columns are adjacent and
+// four columns can go through the butterflies together.
+
+// runs quads*4 rows of the butterfly down every column, carrying c0/c1 along
+static inline void butterfly_quads(int* c0, int* c1, int* buffer, int sb_size, int quads)
+{
+	int i = 0;
+#if defined(__SSE2__)
+	// the results wrap around just like the plain int arithmetic, so this is bit exact
+	for (; i + 4 <= sb_size; i += 4) {
+		__m128i* buff_ptr = ( __m128i * ) ( buffer + i );
+		int step = sb_size >> 2;
+		__m128i db_0 = _mm_loadu_si128( ( __m128i * ) ( c0 + i ) );
+		__m128i db_1 = _mm_loadu_si128( ( __m128i * ) ( c1 + i ) );
+		for (int j = 0; j < quads; j++) {
+			__m128i row_0 = _mm_loadu_si128( buff_ptr );
+			__m128i row_1 = _mm_loadu_si128( buff_ptr + step );
+			__m128i row_2 = _mm_loadu_si128( buff_ptr + 2 * step );
+			__m128i row_3 = _mm_loadu_si128( buff_ptr + 3 * step );
+
+			// db_0 + 2 * db_1 + row_0
+			_mm_storeu_si128( buff_ptr, _mm_add_epi32( _mm_add_epi32( db_0, _mm_slli_epi32( db_1, 1 ) ), row_0 ) );
+			// -db_1 + 2 * row_0 - row_1
+			_mm_storeu_si128( buff_ptr + step, _mm_sub_epi32( _mm_sub_epi32( _mm_slli_epi32( row_0, 1 ), db_1 ), row_1 ) );
+			// row_0 + 2 * row_1 + row_2
+			_mm_storeu_si128( buff_ptr + 2 * step, _mm_add_epi32( _mm_add_epi32( row_0, _mm_slli_epi32( row_1, 1 ) ), row_2 ) );
+			// -row_1 + 2 * row_2 - row_3
+			_mm_storeu_si128( buff_ptr + 3 * step, _mm_sub_epi32( _mm_sub_epi32( _mm_slli_epi32( row_2, 1 ), row_1 ), row_3 ) );
+			buff_ptr += 4 * step;
+
+			db_0 = row_2;
+			db_1 = row_3;
+		}
+		_mm_storeu_si128( ( __m128i * ) ( c0 + i ), db_0 );
+		_mm_storeu_si128( ( __m128i * ) ( c1 + i ), db_1 );
+	}
+#endif
+	// the remaining (or all) columns one at a time
+	for (; i < sb_size; i++) {
+		int* buff_ptr = buffer + i;
+		int db_0 = c0[i], db_1 = c1[i];
+		for (int j = 0; j < quads; j++) {
+			int row_0 = buff_ptr[0];  buff_ptr[0] = db_0 + 2 * db_1 + row_0;  buff_ptr += sb_size;
+			int row_1 = buff_ptr[0];  buff_ptr[0] = -db_1 + 2 * row_0 - row_1;  buff_ptr += sb_size;
+			int row_2 = buff_ptr[0];  buff_ptr[0] = row_0 + 2 * row_1 + row_2;  buff_ptr += sb_size;
+			int row_3 = buff_ptr[0];  buff_ptr[0] = -row_1 + 2 * row_2 - row_3;  buff_ptr += sb_size;
+
+			db_0 = row_2;
+			db_1 = row_3;
+		}
+		c0[i] = db_0;
+		c1[i] = db_1;
+	}
+}
+
 int CSubbandDecoder::init_decoder()
 {
 	int memory_size = ( levels == 0 ) ? 0 : ( 3 * ( block_size >> 1 ) - 2 );
@@ -29,6 +89,10 @@ int CSubbandDecoder::init_decoder()
 		memory_buffer = ( int * ) calloc( memory_size, sizeof( int ) );
 		if (!memory_buffer)
 			return 0;
+		// the first level only keeps shorts, but carries full ints between its rows
+		carry_buffer = ( int * ) malloc( block_size * sizeof( int ) );
+		if (!carry_buffer)
+			return 0;
 	}
 	return 1;
 }
@@ -61,117 +125,47 @@ void CSubbandDecoder::decode_data(int* buffer, int blocks)
 void CSubbandDecoder::sub_4d3fcc(short* memory, int* buffer, int sb_size,
 	int blocks)
 {
-	int row_0, row_1, row_2 = 0, row_3 = 0, db_0, db_1;
+	short* mem_0 = memory, * mem_1 = memory + sb_size;
 	int i;
-	int sb_size_2 = sb_size * 2, sb_size_3 = sb_size * 3;
 	if (blocks == 2) {
 		for (i = 0; i < sb_size; i++) {
-			row_0 = buffer[0];
-			row_1 = buffer[sb_size];
-			buffer[0] = buffer[0] + memory[0] + 2 * memory[1];
-			buffer[sb_size] = 2 * row_0 - memory[1] - buffer[sb_size];
-			memory[0] = ( short ) row_0;
-			memory[1] = ( short ) row_1;
-
-			memory += 2;
-			buffer++;
+			int row_0 = buffer[i];
+			int row_1 = buffer[sb_size + i];
+			buffer[i] = row_0 + mem_0[i] + 2 * mem_1[i];
+			buffer[sb_size + i] = 2 * row_0 - mem_1[i] - row_1;
+			mem_0[i] = ( short ) row_0;
+			mem_1[i] = ( short ) row_1;
 		}
-	} else if (blocks == 4) {
-		for (i = 0; i < sb_size; i++) {
-			row_0 = buffer[0];
-			row_1 = buffer[sb_size];
-			row_2 = buffer[sb_size_2];
-			row_3 = buffer[sb_size_3];
-
-			buffer[0] = memory[0] + 2 * memory[1] + row_0;
-			buffer[sb_size] = -memory[1] + 2 * row_0 - row_1;
-			buffer[sb_size_2] = row_0 + 2 * row_1 + row_2;
-			buffer[sb_size_3] = -row_1 + 2 * row_2 - row_3;
-
-			memory[0] = ( short ) row_2;
-			memory[1] = ( short ) row_3;
+		return;
+	}
 
-			memory += 2;
-			buffer++;
+	int* carry_0 = carry_buffer, * carry_1 = carry_buffer + sb_size;
+	if (( blocks >> 1 ) & 1) {
+		for (i = 0; i < sb_size; i++) {
+			int row_0 = buffer[i];
+			int row_1 = buffer[sb_size + i];
+			buffer[i] = mem_0[i] + 2 * mem_1[i] + row_0;
+			buffer[sb_size + i] = -mem_1[i] + 2 * row_0 - row_1;
+			carry_0[i] = row_0;
+			carry_1[i] = row_1;
 		}
+		buffer += sb_size << 1;
 	} else {
 		for (i = 0; i < sb_size; i++) {
-			int* buff_ptr = buffer;
-			if (( blocks >> 1 ) & 1) {
-				row_0 = buff_ptr[0];
-				row_1 = buff_ptr[sb_size];
-
-				buff_ptr[0] = memory[0] + 2 * memory[1] + row_0;
-				buff_ptr[sb_size] = -memory[1] + 2 * row_0 - row_1;
-				buff_ptr += sb_size_2;
-
-				db_0 = row_0;
-				db_1 = row_1;
-			} else {
-				db_0 = memory[0];
-				db_1 = memory[1];
-			}
-
-			for (int j = 0; j < blocks >> 2; j++) {
-				row_0 = buff_ptr[0];  buff_ptr[0] = db_0 + 2 * db_1 + row_0;  buff_ptr += sb_size;
-				row_1 = buff_ptr[0];  buff_ptr[0] = -db_1 + 2 * row_0 - row_1;  buff_ptr += sb_size;
-				row_2 = buff_ptr[0];  buff_ptr[0] = row_0 + 2 * row_1 + row_2;  buff_ptr += sb_size;
-				row_3 = buff_ptr[0];  buff_ptr[0] = -row_1 + 2 * row_2 -
-					row_3;  buff_ptr += sb_size;
-
-				db_0 = row_2;
-				db_1 = row_3;
-			}
-			memory[0] = ( short ) row_2;
-			memory[1] = ( short ) row_3;
-			memory += 2;
-			buffer++;
+			carry_0[i] = mem_0[i];
+			carry_1[i] = mem_1[i];
 		}
 	}
+
+	butterfly_quads( carry_0, carry_1, buffer, sb_size, blocks >> 2 );
+
+	for (i = 0; i < sb_size; i++) {
+		mem_0[i] = ( short ) carry_0[i];
+		mem_1[i] = ( short ) carry_1[i];
+	}
 }
 void CSubbandDecoder::sub_4d420c(int* memory, int* buffer, int sb_size,
 	int blocks)
 {
-	int row_0, row_1, row_2 = 0, row_3 = 0, db_0, db_1;
-	int i;
-	int sb_size_2 = sb_size * 2, sb_size_3 = sb_size * 3;
-	if (blocks == 4) {
-		for (i = 0; i < sb_size; i++) {
-			row_0 = buffer[0];
-			row_1 = buffer[sb_size];
-			row_2 = buffer[sb_size_2];
-			row_3 = buffer[sb_size_3];
-
-			buffer[0] = memory[0] + 2 * memory[1] + row_0;
-			buffer[sb_size] = -memory[1] + 2 * row_0 - row_1;
-			buffer[sb_size_2] = row_0 + 2 * row_1 + row_2;
-			buffer[sb_size_3] = -row_1 + 2 * row_2 - row_3;
-
-			memory[0] = row_2;
-			memory[1] = row_3;
-
-			memory += 2;
-			buffer++;
-		}
-	} else {
-		for (i = 0; i < sb_size; i++) {
-			int* buff_ptr = buffer;
-			db_0 = memory[0]; db_1 = memory[1];
-			for (int j = 0; j < blocks >> 2; j++) {
-				row_0 = buff_ptr[0];  buff_ptr[0] = db_0 + 2 * db_1 + row_0;  buff_ptr += sb_size;
-				row_1 = buff_ptr[0];  buff_ptr[0] = -db_1 + 2 * row_0 - row_1;  buff_ptr += sb_size;
-				row_2 = buff_ptr[0];  buff_ptr[0] = row_0 + 2 * row_1 + row_2;  buff_ptr += sb_size;
-				row_3 = buff_ptr[0];  buff_ptr[0] = -row_1 + 2 * row_2 -
-					row_3;  buff_ptr += sb_size;
-
-				db_0 = row_2;
-				db_1 = row_3;
-			}
-			memory[0] = row_2;
-			memory[1] = row_3;
-
-			memory += 2;
-			buffer++;
-		}
-	}
+	butterfly_quads( memory, memory + sb_size, buffer, sb_size, blocks >> 2 );
 }
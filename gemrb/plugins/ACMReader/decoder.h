@@ -30,11 +30,13 @@ class CSubbandDecoder {
 private:
 	int levels, block_size;
 	int* memory_buffer;
+	int* carry_buffer; // scratch for the first level
 	void sub_4d3fcc(short* memory, int* buffer, int sb_size, int blocks);
 	void sub_4d420c(int* memory, int* buffer, int sb_size, int blocks);
 public:
 	CSubbandDecoder(int lev_cnt)
-		: levels( lev_cnt ), block_size( 1 << lev_cnt ), memory_buffer( NULL )
+		: levels( lev_cnt ), block_size( 1 << lev_cnt ), memory_buffer( NULL ),
+		carry_buffer( NULL )
 	{
 	}
 	virtual ~CSubbandDecoder()
@@ -42,6 +44,9 @@ public:
 		if (memory_buffer) {
 			free( memory_buffer );
 		}
+		if (carry_buffer) {
+			free( carry_buffer );
+		}
 	}
 
 	int init_decoder();
@@ -85,6 +85,21 @@ FillerProc Fillers[32] = {
 inline void CValueUnpacker::prepare_bits(int bits)
 {
 	while (bits > avail_bits) {
+		// fast path: top up next_bits with as many whole bytes as fit at once
+		if (buffer_bit_offset + 4 <= UNPACKER_BUFFER_SIZE && avail_bits <= 24) {
+			const unsigned char* p = bits_buffer + buffer_bit_offset;
+			unsigned int word = p[0] | ( p[1] << 8 ) | ( p[2] << 16 ) | ( ( unsigned int ) p[3] << 24 );
+			int bytes = ( 32 - avail_bits ) >> 3;
+			if (bytes < 4) {
+				word &= ( 1u << ( bytes << 3 ) ) - 1;
+			}
+			next_bits |= word << avail_bits;
+			avail_bits += bytes << 3;
+			buffer_bit_offset += bytes;
+			continue;
+		}
+
+		// slow path: byte by byte near the end of the buffer, refilling it when needed
 		unsigned char one_byte;
 		if (buffer_bit_offset == UNPACKER_BUFFER_SIZE) {
 			unsigned long remains = stream->Remains();
@@ -44,6 +44,13 @@
 #include <cassert>
 #include <cstdio>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#ifndef NDEBUG
+static void check_sse2_kernels();
+#endif
+#endif
+
 #if HAVE_UNISTD_H
 #include <unistd.h>
 #endif
@@ -78,11 +85,24 @@ BIKPlayer::BIKPlayer(void)
 	video_rendered_frame = validVideo = s_audio = false;
 	s_channels = s_first = s_stream = s_root = 0;
 	s_bands = NULL;
+
+	decoder = NULL;
+	queue_free = SDL_CreateSemaphore(BIK_FRAME_QUEUE);
+	queue_filled = SDL_CreateSemaphore(0);
+	stop_decoding = false;
+	decode_pos = decode_time = 0;
+	c_pic = c_last = NULL;
+
+#if defined(__SSE2__) && !defined(NDEBUG)
+	check_sse2_kernels();
+#endif
 }
 
 BIKPlayer::~BIKPlayer(void)
 {
 	Stop();
+	SDL_DestroySemaphore(queue_free);
+	SDL_DestroySemaphore(queue_filled);
 }
 
 void BIKPlayer::av_set_pts_info(AVRational &time_base, unsigned int pts_num, unsigned int pts_den)
@@ -209,12 +229,40 @@ bool BIKPlayer::Open(DataStream* stream)
 			movieSize.h = header.height;
 			framePos = 0;
 			sound_init( core->GetAudioDrv()->CanPlay());
-			return video_init() == 0;
+			if (video_init()) {
+				return false;
+			}
+#if SDL_VERSION_ATLEAST(1, 3, 0)
+			decoder = SDL_CreateThread(DecoderThread, "BIKDecoder", this);
+#else
+			decoder = SDL_CreateThread(DecoderThread, this);
+#endif
+			if (!decoder) {
+				Log(WARNING, "BIKPlayer", "Unable to start the decoder thread, decoding on demand.");
+			}
+			return true;
 		}
 	}
 	return false;
 }
 
+//this code could be in the movieplayer parent class
+void static get_current_time(long &sec, long &usec) {
+#ifdef _WIN32
+	DWORD time;
+	time = GetTickCount();
+
+	sec = time / 1000;
+	usec = (time % 1000) * 1000;
+#else
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+
+	sec = tv.tv_sec;
+	usec = tv.tv_usec;
+#endif
+}
+
 bool BIKPlayer::DecodeFrame(VideoBuffer& buf)
 {
 	if (!validVideo) {
@@ -227,19 +275,40 @@ bool BIKPlayer::DecodeFrame(VideoBuffer& buf)
 	if(framePos >= header.framecount) {
 		return false;
 	}
-	binkframe frame = frames[framePos++];
-	str->Seek(frame.pos, GEM_STREAM_START);
-	ieDword audframesize;
-	str->ReadDword(&audframesize);
-	frame.size = str->Read( inbuff, frame.size - 4 );
-	if (s_stream > -1 && DecodeAudioFrame(inbuff, audframesize)) {
-		//buggy frame, we stop immediately
-		//return false;
+	QueuedFrame &frame = c_queue[framePos++ % BIK_FRAME_QUEUE];
+	if (decoder) {
+		SDL_SemWait(queue_filled);
+	} else {
+		frame.status = DecodeNextFrame(frame);
 	}
-	if (DecodeVideoFrame(inbuff+audframesize, frame.size-audframesize, buf)) {
+	if (frame.status) {
 		//buggy frame, we stop immediately
+		SDL_SemPost(queue_free);
 		return false;
 	}
+
+	if (frame.samples) {
+		queueBuffer(s_stream, 16, s_channels, frame.samples, frame.samples_size, header.samplerate);
+		free(frame.samples);
+		frame.samples = NULL;
+	}
+
+	if (video_frameskip) {
+		video_frameskip--;
+		video_skippedframes++;
+	} else {
+		const Size& bufsize = buf.Size();
+		int dest_x = unsigned(bufsize.w - header.width) >> 1;
+		int dest_y = unsigned(bufsize.h - header.height) >> 1;
+
+		buf.CopyPixels(Region(dest_x, dest_y, header.width, header.height),
+					   frame.pic.data[0], &frame.pic.linesize[0], // Y
+					   frame.pic.data[1], &frame.pic.linesize[1], // U
+					   frame.pic.data[2], &frame.pic.linesize[2]);// V
+	}
+	//the decoder may reuse the slot now
+	SDL_SemPost(queue_free);
+
 	if (!timer_last_sec) {
 		timer_start();
 	}
@@ -247,21 +316,71 @@ bool BIKPlayer::DecodeFrame(VideoBuffer& buf)
 	return true;
 }
 
-//this code could be in the movieplayer parent class
-void static get_current_time(long &sec, long &usec) {
-#ifdef _WIN32
-	DWORD time;
-	time = GetTickCount();
+//runs on the decoder thread, fills the next free slot of the frame queue
+int BIKPlayer::DecodeNextFrame(QueuedFrame &frame)
+{
+	binkframe bframe = frames[decode_pos++];
+	str->Seek(bframe.pos, GEM_STREAM_START);
+	ieDword audframesize;
+	str->ReadDword(&audframesize);
+	bframe.size = str->Read( inbuff, bframe.size - 4 );
+	if (s_stream > -1 && DecodeAudioFrame(inbuff, audframesize, frame)) {
+		//buggy frame, we stop immediately
+		//return false;
+	}
+	c_pic = &frame.pic;
+	if (DecodeVideoFrame(inbuff+audframesize, bframe.size-audframesize)) {
+		return -1;
+	}
+	//the next frame is based on this one
+	c_last = c_pic;
+	return 0;
+}
 
-	sec = time / 1000;
-	usec = (time % 1000) * 1000;
-#else
-	struct timeval tv;
-	gettimeofday(&tv, NULL);
+int BIKPlayer::DecoderThread(void *arg)
+{
+	BIKPlayer *player = (BIKPlayer *) arg;
+	long start_sec, start_usec, sec, usec;
 
-	sec = tv.tv_sec;
-	usec = tv.tv_usec;
-#endif
+	while (player->decode_pos < player->header.framecount) {
+		SDL_SemWait(player->queue_free);
+		if (player->stop_decoding) {
+			break;
+		}
+
+		get_current_time(start_sec, start_usec);
+		QueuedFrame &frame = player->c_queue[player->decode_pos % BIK_FRAME_QUEUE];
+		frame.status = player->DecodeNextFrame(frame);
+		get_current_time(sec, usec);
+		player->decode_time += (sec - start_sec) * 1000 + (usec - start_usec) / 1000;
+
+		SDL_SemPost(player->queue_filled);
+		if (frame.status) {
+			break;
+		}
+	}
+	return 0;
+}
+
+void BIKPlayer::StopDecoder()
+{
+	if (!decoder) {
+		return;
+	}
+	stop_decoding = true;
+	//wake it up in case it waits for a free slot
+	SDL_SemPost(queue_free);
+	SDL_WaitThread(decoder, NULL);
+	decoder = NULL;
+
+	if (decode_pos) {
+		Log(DEBUG, "BIKPlayer", "Decoded %u frames in %ums (%.1f fps), %u were skipped",
+			decode_pos, decode_time, decode_time ? decode_pos * 1000.0 / decode_time : 0.0, video_skippedframes);
+	}
+	for (int i = 0; i < BIK_FRAME_QUEUE; i++) {
+		free(c_queue[i].samples);
+		c_queue[i].samples = NULL;
+	}
 }
 
 void BIKPlayer::timer_start()
@@ -298,6 +417,7 @@ void BIKPlayer::timer_wait()
 
 void BIKPlayer::Stop()
 {
+	StopDecoder();
 	if (s_stream > -1)
 		EndAudio();
 	EndVideo();
@@ -460,12 +580,12 @@ int BIKPlayer::video_init()
 		}
 	}
 	
-	c_pic = &c_frames[0];
-	c_last = &c_frames[1];
-	
-	c_pic->get_buffer(header.width, header.height);
-	c_last->get_buffer(header.width, header.height);
-	
+	for (i = 0; i < BIK_FRAME_QUEUE; i++) {
+		c_queue[i].pic.get_buffer(header.width, header.height);
+	}
+	c_pic = &c_queue[0].pic;
+	c_last = &c_queue[BIK_FRAME_QUEUE - 1].pic;
+
 
 	ff_init_scantable(&c_scantable, bink_scan);
 
@@ -650,7 +770,7 @@ void BIKPlayer::DecodeBlock(short *out)
 }
 
 //audio samples
-int BIKPlayer::DecodeAudioFrame(void *data, int data_size)
+int BIKPlayer::DecodeAudioFrame(void *data, int data_size, QueuedFrame &frame)
 {
 	if (data_size == 0) return 0;
 	
@@ -679,9 +799,10 @@ int BIKPlayer::DecodeAudioFrame(void *data, int data_size)
 	//ret is a better value here as it provides almost perfect sound.
 	//Original ffmpeg code produces worse results with reported_size.
 	//Ideally ret == reported_size
-	queueBuffer(s_stream, 16, s_channels, samples, ret, header.samplerate);
-
-	free(samples);
+	//the samples are queued by DecodeFrame, once the frame is shown
+	free(frame.samples);
+	frame.samples = samples;
+	frame.samples_size = ret;
 	return reported_size!=ret;
 }
 
@@ -1146,26 +1267,10 @@ inline int BIKPlayer::get_value(int bundle)
 	dst[(x)*2 +     ((y)*2 + 1) * stride] = \
 	dst[(x)*2 + 1 + ((y)*2 + 1) * stride] = pix;
 
-static void get_pixels(DCTELEM *block, const uint8_t *pixels, int line_size)
-{
-	int i;
-
-	/* read the pixels */
-	for(i=0;i<8;i++) {
-		block[0] = pixels[0];
-		block[1] = pixels[1];
-		block[2] = pixels[2];
-		block[3] = pixels[3];
-		block[4] = pixels[4];
-		block[5] = pixels[5];
-		block[6] = pixels[6];
-		block[7] = pixels[7];
-		pixels += line_size;
-		block += 8;
-	}
-}
-
-static void put_pixels_nonclamped(const DCTELEM *block, uint8_t *pixels, int line_size)
+// plain versions, the SSE2 ones below are checked against them
+#if !defined(__SSE2__) || !defined(NDEBUG)
+// the nonclamped variants keep only the low byte of each result, like the plain assignment
+static void put_pixels_nonclamped_c(const DCTELEM *block, uint8_t *pixels, int line_size)
 {
 	int i;
 	/* read the pixels */
@@ -1183,7 +1288,7 @@ static void put_pixels_nonclamped(const DCTELEM *block, uint8_t *pixels, int lin
 	}
 }
 
-static void add_pixels_nonclamped(const DCTELEM *block, uint8_t *pixels, int line_size)
+static void add_pixels_nonclamped_c(const DCTELEM *block, uint8_t *pixels, int line_size)
 {
 	int i;
 
@@ -1201,11 +1306,81 @@ static void add_pixels_nonclamped(const DCTELEM *block, uint8_t *pixels, int lin
 		block += 8;
 	}
 }
+#endif
+
+#if defined(__SSE2__)
+static void put_pixels_nonclamped(const DCTELEM *block, uint8_t *pixels, int line_size)
+{
+	const __m128i mask = _mm_set1_epi16(0xFF);
+	int i;
+
+	for(i=0;i<8;i++) {
+		__m128i row = _mm_and_si128(_mm_loadu_si128((const __m128i *) block), mask);
+		_mm_storel_epi64((__m128i *) pixels, _mm_packus_epi16(row, row));
+		pixels += line_size;
+		block += 8;
+	}
+}
 
-static inline void copy_block(DCTELEM block[64], const uint8_t *src, uint8_t *dst, int stride)
+static void add_pixels_nonclamped(const DCTELEM *block, uint8_t *pixels, int line_size)
 {
-	get_pixels(block, src, stride);
-	put_pixels_nonclamped(block, dst, stride);
+	const __m128i mask = _mm_set1_epi16(0xFF);
+	const __m128i zero = _mm_setzero_si128();
+	int i;
+
+	for(i=0;i<8;i++) {
+		__m128i row = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) pixels), zero);
+		row = _mm_add_epi16(row, _mm_loadu_si128((const __m128i *) block));
+		row = _mm_and_si128(row, mask);
+		_mm_storel_epi64((__m128i *) pixels, _mm_packus_epi16(row, row));
+		pixels += line_size;
+		block += 8;
+	}
+}
+
+#ifndef NDEBUG
+// compare the SSE2 kernels with the plain ones on pseudo random blocks
+static void check_sse2_kernels()
+{
+	static bool checked = false;
+	DCTELEM block[64], ref[64];
+	uint8_t pixels[64], refpixels[64];
+	unsigned int seed = 0x1234567;
+	int n, i;
+
+	if (checked) return;
+	checked = true;
+	for (n = 0; n < 256; n++) {
+		for (i = 0; i < 64; i++) {
+			seed = seed * 1103515245 + 12345;
+			block[i] = ref[i] = (DCTELEM) (seed >> 16);
+			refpixels[i] = pixels[i] = (uint8_t) (seed >> 8);
+		}
+		add_pixels_nonclamped(block, pixels, 8);
+		add_pixels_nonclamped_c(ref, refpixels, 8);
+		assert(!memcmp(pixels, refpixels, sizeof(pixels)));
+
+		put_pixels_nonclamped(block, pixels, 8);
+		put_pixels_nonclamped_c(ref, refpixels, 8);
+		assert(!memcmp(pixels, refpixels, sizeof(pixels)));
+	}
+}
+#endif
+#else
+#define put_pixels_nonclamped put_pixels_nonclamped_c
+#define add_pixels_nonclamped add_pixels_nonclamped_c
+#endif
+
+// the source is always the previous frame, so it never overlaps the destination
+static inline void copy_block(const uint8_t *src, uint8_t *dst, int stride)
+{
+	int i;
+
+	for(i=0;i<8;i++) {
+		memcpy(dst, src, 8);
+		src += stride;
+		dst += stride;
+	}
 }
 
 #define clear_block(block) memset( (block), 0, sizeof(DCTELEM)*64);
@@ -1299,7 +1474,7 @@ static void idct_add(uint8_t *dest, int line_size, DCTELEM *block)
 	add_pixels_nonclamped(block, dest, line_size);
 }
 
-int BIKPlayer::DecodeVideoFrame(void *data, int data_size, VideoBuffer& buf)
+int BIKPlayer::DecodeVideoFrame(void *data, int data_size)
 {
 	int blk, bw, bh;
 	int i, j, plane, bx, by;
@@ -1364,7 +1539,7 @@ int BIKPlayer::DecodeVideoFrame(void *data, int data_size, VideoBuffer& buf)
 				}
 				switch (blk) {
 				case SKIP_BLOCK:
-					copy_block(block, prev, dst, stride);
+					copy_block(prev, dst, stride);
 					break;
 				case SCALED_BLOCK:
 					blk = get_value(BINK_SRC_SUB_BLOCK_TYPES);
@@ -1438,7 +1613,7 @@ int BIKPlayer::DecodeVideoFrame(void *data, int data_size, VideoBuffer& buf)
 				case MOTION_BLOCK:
 					xoff = get_value(BINK_SRC_X_OFF);
 					yoff = get_value(BINK_SRC_Y_OFF);
-					copy_block(block, prev + xoff + yoff*stride, dst, stride);
+					copy_block(prev + xoff + yoff*stride, dst, stride);
 					break;
 				case RUN_BLOCK:
 					scan = bink_patterns[v_gb.get_bits(4)];
@@ -1467,7 +1642,7 @@ int BIKPlayer::DecodeVideoFrame(void *data, int data_size, VideoBuffer& buf)
 				case RESIDUE_BLOCK:
 					xoff = get_value(BINK_SRC_X_OFF);
 					yoff = get_value(BINK_SRC_Y_OFF);
-					copy_block(block, prev + xoff + yoff*stride, dst, stride);
+					copy_block(prev + xoff + yoff*stride, dst, stride);
 					clear_block(block);
 					v = v_gb.get_bits(7);
 					read_residue(block, v);
@@ -1488,7 +1663,7 @@ int BIKPlayer::DecodeVideoFrame(void *data, int data_size, VideoBuffer& buf)
 				case INTER_BLOCK:
 					xoff = get_value(BINK_SRC_X_OFF);
 					yoff = get_value(BINK_SRC_Y_OFF);
-					copy_block(block, prev + xoff + yoff*stride, dst, stride);
+					copy_block(prev + xoff + yoff*stride, dst, stride);
 					clear_block(block);
 					block[0] = get_value(BINK_SRC_INTER_DC);
 					read_dct_coeffs(block, c_scantable.permutated,false);
@@ -1519,21 +1694,6 @@ int BIKPlayer::DecodeVideoFrame(void *data, int data_size, VideoBuffer& buf)
 		v_gb.get_bits_align32();
 	}
 
-	if (video_frameskip) {
-		video_frameskip--;
-		video_skippedframes++;
-	} else {
-		const Size& bufsize = buf.Size();
-		int dest_x = unsigned(bufsize.w - header.width) >> 1;
-		int dest_y = unsigned(bufsize.h - header.height) >> 1;
-
-		buf.CopyPixels(Region(dest_x, dest_y, header.width, header.height),
-					   c_pic->data[0], &c_pic->linesize[0], // Y
-					   c_pic->data[1], &c_pic->linesize[1], // U
-					   c_pic->data[2], &c_pic->linesize[2]);// V
-	}
-
-	std::swap(c_pic, c_last);
 	return 0;
 }
 
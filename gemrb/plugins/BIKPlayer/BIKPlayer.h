@@ -26,6 +26,9 @@
 #include "globals.h"
 #include "win32def.h"
 
+#include <SDL_mutex.h>
+#include <SDL_thread.h>
+
 // FIXME: This has to be included last, since it defines int*_t, which causes
 // mingw g++ 4.5.0 to choke.
 #include "GetBitContext.h"
@@ -41,6 +44,7 @@ namespace GemRB {
 #define BIK_SIGNATURE_DATA "BIKi"
 
 #define MAX_CHANNELS 2
+#define BIK_FRAME_QUEUE 3 //frames the decoder thread may get ahead of the display
 #define BINK_BLOCK_MAX_SIZE (MAX_CHANNELS << 11)
 
 #if defined(__arm__)
@@ -180,6 +184,16 @@ typedef struct {
 	ieDword size;
 } binkframe;
 
+// a decoded frame waiting in the queue between the decoder thread and the display
+typedef struct QueuedFrame {
+	AVFrame pic;
+	ieWordSigned *samples; ///< decoded audio of the frame, queued once it is shown
+	unsigned int samples_size; ///< in bytes
+	int status; ///< nonzero if the frame couldn't be decoded
+
+	QueuedFrame() : samples(NULL), samples_size(0), status(0) {}
+} QueuedFrame;
+
 typedef struct Bundle {
 	  int     len;       ///< length of number of entries to decode (in bits)
 	  Tree    tree;      ///< Huffman tree-related data
@@ -240,9 +254,17 @@ private:
 	int16_t table[16 * 128][2];
 	GetBitContext v_gb;
 	
-	AVFrame c_frames[2];
+	QueuedFrame c_queue[BIK_FRAME_QUEUE];
 	AVFrame *c_pic, *c_last;
 
+	//decoder thread, runs up to BIK_FRAME_QUEUE frames ahead of DecodeFrame
+	SDL_Thread *decoder;
+	SDL_sem *queue_free;   ///< slots the decoder may fill
+	SDL_sem *queue_filled; ///< slots ready for display
+	bool stop_decoding;
+	unsigned int decode_pos;  ///< next frame for the decoder
+	unsigned int decode_time; ///< ms spent decoding, for the statistics
+
 private:
 	void timer_start();
 	void timer_wait();
@@ -259,7 +281,7 @@ private:
 	void av_set_pts_info(AVRational &time_base, unsigned int pts_num, unsigned int pts_den);
 	int ReadHeader();
 	void DecodeBlock(short *out);
-	int DecodeAudioFrame(void *data, int data_size);
+	int DecodeAudioFrame(void *data, int data_size, QueuedFrame &frame);
 	inline int get_value(int bundle);
 	int read_dct_coeffs(DCTELEM block[64], const uint8_t *scan, bool is_intra);
 	int read_residue(DCTELEM block[64], int masks_count);
@@ -272,7 +294,10 @@ private:
 	int get_vlc2(int16_t (*table)[2], int bits, int max_depth);
 	void read_bundle(int bundle_num);
 	void init_lengths(int width, int bw);
-	int DecodeVideoFrame(void *data, int data_size, VideoBuffer& buf);
+	int DecodeVideoFrame(void *data, int data_size);
+	int DecodeNextFrame(QueuedFrame &frame);
+	static int DecoderThread(void *arg);
+	void StopDecoder();
 	int EndAudio();
 	int EndVideo();
 
@@ -6105,6 +6105,38 @@ static PyObject* GemRB_GetPlayerStat(PyObject * /*self*/, PyObject* args)
 	return PyInt_FromLong( StatValue );
 }
 
+PyDoc_STRVAR( GemRB_GetPlayerStats__doc,
+"===== GetPlayerStats =====\n\
+\n\
+**Prototype:** GemRB.GetPlayerStats(globalID[, Base])\n\
+\n\
+**Description:** Queries all the stats of the player character at once, \n\
+which is much cheaper than calling GetPlayerStat for each of them when \n\
+filling whole screens (eg. the record sheet).\n\
+\n\
+**Parameters:**\n\
+  * globalID - party ID or global ID of the actor to use\n\
+  * Base - if set to 1, the function will return the base instead of the modified (current) values\n\
+\n\
+**Return value:** tuple, indexed by the stat indices from ie_stats.py\n\
+\n\
+**See also:** [[guiscript:GetPlayerStat]]"
+);
+
+static PyObject* GemRB_GetPlayerStats(PyObject * /*self*/, PyObject* args)
+{
+	int globalID, BaseStat = 0;
+	PARSE_ARGS2( args,  "i|i", &globalID, &BaseStat );
+	GET_GAME();
+	GET_ACTOR_GLOBAL();
+
+	PyObject* stats = PyTuple_New(MAX_STATS);
+	for (int StatID = 0; StatID < MAX_STATS; StatID++) {
+		PyTuple_SET_ITEM(stats, StatID, PyInt_FromLong(GetCreatureStat(actor, StatID, !BaseStat)));
+	}
+	return stats;
+}
+
 PyDoc_STRVAR( GemRB_SetPlayerStat__doc,
 "===== SetPlayerStat =====\n\
 \n\
@@ -7960,6 +7992,41 @@ static PyObject* GemRB_GetKnownSpell(PyObject * /*self*/, PyObject* args)
 }
 
 
+PyDoc_STRVAR( GemRB_GetKnownSpellList__doc,
+"===== GetKnownSpellList =====\n\
+\n\
+**Prototype:** GemRB.GetKnownSpellList (PartyID, SpellType, Level)\n\
+\n\
+**Description:** Returns all the known spells of the given type and level \n\
+from PC's spellbook in one go.\n\
+\n\
+**Parameters:**\n\
+  * PartyID   - the PC's position in the party\n\
+  * SpellType - 0 - priest, 1 - wizard, 2 - innate\n\
+  * Level     - the known spells' level\n\
+\n\
+**Return value:** tuple of dictionaries, like the ones returned by GetKnownSpell\n\
+\n\
+**See also:** [[guiscript:GetKnownSpell]], [[guiscript:GetMemorizedSpellList]]\n\
+"
+);
+
+static PyObject* GemRB_GetKnownSpellList(PyObject * /*self*/, PyObject* args)
+{
+	int globalID, SpellType, Level;
+	PARSE_ARGS3( args,  "iii", &globalID, &SpellType, &Level);
+	GET_GAME();
+	GET_ACTOR_GLOBAL();
+
+	unsigned int count = actor->spellbook.GetKnownSpellsCount( SpellType, Level );
+	PyObject* spells = PyTuple_New(count);
+	for (unsigned int i = 0; i < count; i++) {
+		CREKnownSpell* ks = actor->spellbook.GetKnownSpell( SpellType, Level, i );
+		PyTuple_SET_ITEM(spells, i, Py_BuildValue("{s:s}", "SpellResRef", ks->SpellResRef));
+	}
+	return spells;
+}
+
 PyDoc_STRVAR( GemRB_GetMemorizedSpellsCount__doc,
 "===== GetMemorizedSpellsCount =====\n\
 \n\
@@ -8036,6 +8103,42 @@ static PyObject* GemRB_GetMemorizedSpell(PyObject * /*self*/, PyObject* args)
 }
 
 
+PyDoc_STRVAR( GemRB_GetMemorizedSpellList__doc,
+"===== GetMemorizedSpellList =====\n\
+\n\
+**Prototype:** GemRB.GetMemorizedSpellList (PartyID, SpellType, Level)\n\
+\n\
+**Description:** Returns all the memorized spells of the given type and \n\
+level from PC's spellbook in one go, including the depleted ones.\n\
+\n\
+**Parameters:** \n\
+  * PartyID   - the PC's position in the party\n\
+  * SpellType - 0 - priest, 1 - wizard, 2 - innate\n\
+  * Level     - the memorized spells' level\n\
+\n\
+**Return value:** tuple of dictionaries, like the ones returned by GetMemorizedSpell\n\
+\n\
+**See also:** [[guiscript:GetMemorizedSpell]], [[guiscript:GetKnownSpellList]]\n\
+"
+);
+
+static PyObject* GemRB_GetMemorizedSpellList(PyObject * /*self*/, PyObject* args)
+{
+	int globalID, SpellType, Level;
+	PARSE_ARGS3( args,  "iii", &globalID, &SpellType, &Level);
+	GET_GAME();
+	GET_ACTOR_GLOBAL();
+
+	unsigned int count = actor->spellbook.GetMemorizedSpellsCount( SpellType, Level, false );
+	PyObject* spells = PyTuple_New(count);
+	for (unsigned int i = 0; i < count; i++) {
+		CREMemorizedSpell* ms = actor->spellbook.GetMemorizedSpell( SpellType, Level, i );
+		PyTuple_SET_ITEM(spells, i, Py_BuildValue("{s:s,s:i}", "SpellResRef", ms->SpellResRef, "Flags", ms->Flags));
+	}
+	return spells;
+}
+
+
 PyDoc_STRVAR( GemRB_GetSpell__doc,
 "===== GetSpell =====\n\
 \n\
@@ -8514,6 +8617,22 @@ the slot will not be looked up again.\n\
 **See also:** [[guiscript:GetItem]], [[guiscript:Button_SetItemIcon]], [[guiscript:ChangeItemFlag]]"
 );
 
+static PyObject* MakeSlotItemDict(const CREItem *si, int header)
+{
+	if (! si) {
+		Py_RETURN_NONE;
+	}
+	PyObject* dict = PyDict_New();
+	PyDict_SetItemString(dict, "ItemResRef", PyString_FromResRef (si->ItemResRef));
+	PyDict_SetItemString(dict, "Usages0", PyInt_FromLong (si->Usages[0]));
+	PyDict_SetItemString(dict, "Usages1", PyInt_FromLong (si->Usages[1]));
+	PyDict_SetItemString(dict, "Usages2", PyInt_FromLong (si->Usages[2]));
+	PyDict_SetItemString(dict, "Flags", PyInt_FromLong (si->Flags));
+	PyDict_SetItemString(dict, "Header", PyInt_FromLong (header));
+
+	return dict;
+}
+
 static PyObject* GemRB_GetSlotItem(PyObject * /*self*/, PyObject* args)
 {
 	int globalID, Slot;
@@ -8535,18 +8654,58 @@ static PyObject* GemRB_GetSlotItem(PyObject * /*self*/, PyObject* args)
 
 		si = actor->inventory.GetSlotItem( Slot );
 	}
-	if (! si) {
-		Py_RETURN_NONE;
-	}
-	PyObject* dict = PyDict_New();
-	PyDict_SetItemString(dict, "ItemResRef", PyString_FromResRef (si->ItemResRef));
-	PyDict_SetItemString(dict, "Usages0", PyInt_FromLong (si->Usages[0]));
-	PyDict_SetItemString(dict, "Usages1", PyInt_FromLong (si->Usages[1]));
-	PyDict_SetItemString(dict, "Usages2", PyInt_FromLong (si->Usages[2]));
-	PyDict_SetItemString(dict, "Flags", PyInt_FromLong (si->Flags));
-	PyDict_SetItemString(dict, "Header", PyInt_FromLong (header));
+	return MakeSlotItemDict(si, header);
+}
 
-	return dict;
+PyDoc_STRVAR( GemRB_GetSlotItems__doc,
+"===== GetSlotItems =====\n\
+\n\
+**Prototype:** GemRB.GetSlotItems (PartyID, slots[, translated])\n\
+\n\
+**Description:** Returns the items of several inventory slots at once, eg. \n\
+to fill a whole inventory screen with a single call.\n\
+\n\
+**Parameters:**\n\
+  * PartyID    - the PC's position in the party\n\
+  * slots      - a sequence of inventory slots\n\
+  * translated - the slots don't need to be looked up again\n\
+\n\
+**Return value:** tuple with an entry for each requested slot, either None \n\
+for empty slots or a dictionary like the ones returned by GetSlotItem\n\
+\n\
+**See also:** [[guiscript:GetSlotItem]]"
+);
+
+static PyObject* GemRB_GetSlotItems(PyObject * /*self*/, PyObject* args)
+{
+	int globalID;
+	PyObject* slotList;
+	int translated = 0;
+	PARSE_ARGS3( args,  "iO|i", &globalID, &slotList, &translated);
+	GET_GAME();
+	GET_ACTOR_GLOBAL();
+
+	PyObject* slots = PySequence_Fast(slotList, "slots must be a sequence");
+	if (!slots) {
+		return NULL;
+	}
+	Py_ssize_t count = PySequence_Fast_GET_SIZE(slots);
+	PyObject* items = PyTuple_New(count);
+	for (Py_ssize_t i = 0; i < count; i++) {
+		int Slot = PyInt_AsLong(PySequence_Fast_GET_ITEM(slots, i));
+		if (PyErr_Occurred()) {
+			Py_DECREF(items);
+			Py_DECREF(slots);
+			return AttributeError("Slots must be integers");
+		}
+		if (!translated) {
+			Slot = core->QuerySlot(Slot);
+		}
+		int header = (actor->PCStats) ? actor->PCStats->GetHeaderForSlot(Slot) : -1;
+		PyTuple_SET_ITEM(items, i, MakeSlotItemDict(actor->inventory.GetSlotItem(Slot), header));
+	}
+	Py_DECREF(slots);
+	return items;
 }
 
 PyDoc_STRVAR( GemRB_ChangeItemFlag__doc,
@@ -12851,12 +13010,14 @@ static PyMethodDef GemRBMethods[] = {
 	METHOD(GetJournalEntry, METH_VARARGS),
 	METHOD(GetJournalSize, METH_VARARGS),
 	METHOD(GetKnownSpell, METH_VARARGS),
+	METHOD(GetKnownSpellList, METH_VARARGS),
 	METHOD(GetKnownSpellsCount, METH_VARARGS),
 	METHOD(GetMaxEncumbrance, METH_VARARGS),
 	METHOD(GetMazeEntry, METH_VARARGS),
 	METHOD(GetMazeHeader, METH_NOARGS),
 	METHOD(GetMemorizableSpellsCount, METH_VARARGS),
 	METHOD(GetMemorizedSpell, METH_VARARGS),
+	METHOD(GetMemorizedSpellList, METH_VARARGS),
 	METHOD(GetMemorizedSpellsCount, METH_VARARGS),
 	METHOD(GetMultiClassPenalty, METH_VARARGS),
 	METHOD(MessageWindowDebug, METH_VARARGS),
@@ -12865,6 +13026,7 @@ static PyMethodDef GemRBMethods[] = {
 	METHOD(GetPlayerName, METH_VARARGS),
 	METHOD(GetPlayerPortrait, METH_VARARGS),
 	METHOD(GetPlayerStat, METH_VARARGS),
+	METHOD(GetPlayerStats, METH_VARARGS),
 	METHOD(GetPlayerStates, METH_VARARGS),
 	METHOD(GetPlayerScript, METH_VARARGS),
 	METHOD(GetPlayerSound, METH_VARARGS),
@@ -12885,6 +13047,7 @@ static PyMethodDef GemRBMethods[] = {
 	METHOD(GetSpelldata, METH_VARARGS),
 	METHOD(GetSpelldataIndex, METH_VARARGS),
 	METHOD(GetSlotItem, METH_VARARGS),
+	METHOD(GetSlotItems, METH_VARARGS),
 	METHOD(GetSlots, METH_VARARGS),
 	METHOD(GetSystemVariable, METH_VARARGS),
 	METHOD(GetToken, METH_VARARGS),
@@ -13063,6 +13226,7 @@ GUIScript::GUIScript(void)
 GUIScript::~GUIScript(void)
 {
 	if (Py_IsInitialized()) {
+		ClearFunctionCache();
 		if (pModule) {
 			Py_DECREF( pModule );
 		}
@@ -13252,6 +13416,8 @@ bool GUIScript::LoadScript(const char* filename)
 	if (pModule) {
 		Py_DECREF( pModule );
 	}
+	// the main script changes, so drop everything resolved so far
+	ClearFunctionCache();
 
 	pModule = PyImport_Import( pName );
 	Py_DECREF( pName );
@@ -13296,42 +13462,83 @@ bool GUIScript::RunFunction(const char* Modulename, const char* FunctionName, co
 	return ret;
 }
 
-/* Similar to RunFunction, but with parameters, and doesn't necessarily fail */
-PyObject *GUIScript::RunFunction(const char* moduleName, const char* functionName, PyObject* pArgs, bool report_error)
+void GUIScript::ClearFunctionCache()
 {
-	if (!Py_IsInitialized()) {
-		return NULL;
+	FunctionCache::iterator it = functionCache.begin();
+	for (; it != functionCache.end(); ++it) {
+		Py_XDECREF(it->second.moduleName);
+		Py_XDECREF(it->second.module);
+		Py_DECREF(it->second.functionName);
 	}
+	functionCache.clear();
+}
+
+/* returns a new reference to the function or NULL (without an exception set) if it doesn't exist */
+PyObject* GUIScript::ResolveFunction(const char* moduleName, const char* functionName)
+{
+	std::string key = (moduleName) ? moduleName : "";
+	key.append(":").append(functionName);
+
+	FunctionCache::iterator it = functionCache.find(key);
+	if (it == functionCache.end()) {
+		ResolvedFunction resolved;
+		resolved.moduleName = (moduleName) ? PyString_FromString(moduleName) : NULL;
+		resolved.module = NULL;
+		resolved.functionName = PyString_InternFromString(functionName);
+		it = functionCache.insert(std::make_pair(key, resolved)).first;
+	}
+	ResolvedFunction& resolved = it->second;
 
 	PyObject *module;
-	if (moduleName) {
-		module = PyImport_ImportModule(moduleName);
+	if (resolved.moduleName) {
+		// a module that was removed from sys.modules (or never imported) needs a real import
+		if (!resolved.module || PyDict_GetItem(PyImport_GetModuleDict(), resolved.moduleName) != resolved.module) {
+			Py_XDECREF(resolved.module);
+			resolved.module = PyImport_Import(resolved.moduleName);
+			if (resolved.module == NULL) {
+				PyErr_Print();
+				return NULL;
+			}
+		}
+		module = resolved.module;
 	} else {
 		module = pModule;
-		Py_XINCREF(module);
-	}
-	if (module == NULL) {
-		PyErr_Print();
-		return NULL;
+		if (module == NULL) {
+			return NULL;
+		}
 	}
-	PyObject *dict = PyModule_GetDict(module);
 
-	PyObject *pFunc = PyDict_GetItemString(dict, functionName);
+	PyObject *pFunc = PyDict_GetItem(PyModule_GetDict(module), resolved.functionName);
 	/* pFunc: Borrowed reference */
 	if (!PyCallable_Check(pFunc)) {
+		return NULL;
+	}
+	Py_INCREF(pFunc);
+	return pFunc;
+}
+
+/* Similar to RunFunction, but with parameters, and doesn't necessarily fail */
+PyObject *GUIScript::RunFunction(const char* moduleName, const char* functionName, PyObject* pArgs, bool report_error)
+{
+	if (!Py_IsInitialized()) {
+		return NULL;
+	}
+
+	PyObject *pFunc = ResolveFunction(moduleName, functionName);
+	if (pFunc == NULL) {
 		if (report_error) {
 			Log(ERROR, "GUIScript", "Missing function: %s from %s", functionName, moduleName);
 		}
-		Py_DECREF(module);
 		return NULL;
 	}
+	// the function could drop the last reference to itself (eg. by rebinding its name)
 	PyObject *pValue = PyObject_CallObject( pFunc, pArgs );
 	if (pValue == NULL) {
 		if (PyErr_Occurred()) {
 			PyErr_Print();
 		}
 	}
-	Py_DECREF(module);
+	Py_DECREF(pFunc);
 	return pValue;
 }
 
@@ -13341,7 +13548,9 @@ bool GUIScript::RunFunction(const char *moduleName, const char* functionName, bo
 	if (intparam == -1) {
 		pArgs = NULL;
 	} else {
-		pArgs = Py_BuildValue("(i)", intparam);
+		// cheaper than parsing a format string with Py_BuildValue
+		pArgs = PyTuple_New(1);
+		PyTuple_SET_ITEM(pArgs, 0, PyInt_FromLong(intparam));
 	}
 	PyObject *pValue = RunFunction(moduleName, functionName, pArgs, report_error);
 	Py_XDECREF(pArgs);
@@ -25,6 +25,9 @@
 
 #include "ScriptEngine.h"
 
+#include <map>
+#include <string>
+
 namespace GemRB {
 
 class Control;
@@ -41,6 +44,19 @@ private:
 	PyObject* pMainDic;
 	PyObject* pGUIClasses;
 
+	// the engine calls the same few hooks over and over (UpdatePortraitWindow & co.)
+	// so keep the imported module and prebuilt name objects around instead of importing every time
+	struct ResolvedFunction {
+		PyObject* moduleName; // key into sys.modules, NULL for the main script
+		PyObject* module; // validated against sys.modules on each call, so reimports are noticed
+		PyObject* functionName; // looked up each call, since scripts may rebind their functions
+	};
+	typedef std::map<std::string, ResolvedFunction> FunctionCache;
+	FunctionCache functionCache;
+
+	PyObject* ResolveFunction(const char* moduleName, const char* functionName);
+	void ClearFunctionCache();
+
 public:
 	GUIScript(void);
 	~GUIScript(void);
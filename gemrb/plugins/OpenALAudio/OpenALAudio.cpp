@@ -23,7 +23,9 @@
 #include "GameData.h"
 #include "Interface.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cctype>
 #include <cstdio>
 
 using namespace GemRB;
@@ -110,7 +112,11 @@ void AudioStream::ClearProcessedBuffers()
 		alSourceUnqueueBuffers( Source, processed, b );
 		checkALError("Failed to unqueue buffers", WARNING);
 
-		if (delete_buffers) {
+		if (!delete_buffers) {
+			for (int i = 0; i < processed; i++) {
+				driver->releaseBuffer(b[i]);
+			}
+		} else {
 #ifdef __APPLE__ // mac os x and iOS
 			/* FIXME: hackish
 				somebody with more knowledge than me could perhapps figure out
@@ -146,6 +152,7 @@ void AudioStream::ClearIfStopped()
 			state == AL_STOPPED)
 	{
 		ClearProcessedBuffers();
+		CancelPending();
 		alDeleteSources( 1, &Source );
 		checkALError("Failed to delete source", WARNING);
 		Source = 0;
@@ -168,16 +175,39 @@ void AudioStream::ForceClear()
 	ClearIfStopped();
 }
 
+void AudioStream::CancelPending()
+{
+	if (!pending) return;
+
+	// the decoder may be just about to queue the buffer
+	SDL_mutex* mutex = pending->mutex;
+	SDL_mutexP(mutex);
+	pending->Source = 0;
+	pending.release();
+	SDL_mutexV(mutex);
+}
+
 OpenALAudioDriver::OpenALAudioDriver(void)
 {
 	alutContext = NULL;
 	MusicPlaying = false;
-	music_memory = (short*) malloc(ACM_BUFFERSIZE);
+	music_memory = (short*) malloc(MUSICBUFFERS * ACM_BUFFERSIZE);
 	MusicSource = num_streams = 0;
 	memset(MusicBuffer, 0, MUSICBUFFERS*sizeof(ALuint));
 	musicMutex = SDL_CreateMutex();
+	musicDecoding = false;
+	musicGeneration = 0;
+	memset(&musicLockStats, 0, sizeof(musicLockStats));
+	bufferMutex = SDL_CreateMutex();
+	decodeSem = SDL_CreateSemaphore(0);
+	memset(&cacheStats, 0, sizeof(cacheStats));
+	for (int i = 0; i < MAX_STREAMS; i++) {
+		streams[i].driver = this;
+	}
+	speech.driver = this;
 	ambim = NULL;
 	musicThread = NULL;
+	decodeThread = NULL;
 	stayAlive = false;
 	hasReverbProperties = false;
 #ifdef HAVE_OPENAL_EFX_H
@@ -246,9 +276,14 @@ bool OpenALAudioDriver::Init(void)
 #if	SDL_VERSION_ATLEAST(1, 3, 0)
 	/* as of changeset 3a041d215edc SDL_CreateThread has a 'name' parameter */
 	musicThread = SDL_CreateThread( MusicManager, "OpenALAudio", this );
+	decodeThread = SDL_CreateThread( DecodeManager, "OpenALDecoder", this );
 #else
 	musicThread = SDL_CreateThread( MusicManager, this );
+	decodeThread = SDL_CreateThread( DecodeManager, this );
 #endif
+	if (!decodeThread) {
+		Log(WARNING, "OpenAL", "Unable to start the decoder thread, sounds will be decoded on demand.");
+	}
 
 	if (!InitEFX()) {
 		Log(MESSAGE, "OpenAL", "EFX not available.");
@@ -348,9 +383,13 @@ OpenALAudioDriver::~OpenALAudioDriver(void)
 	}
 
 	stayAlive = false;
+	SDL_SemPost(decodeSem);
 // AmigaOS4 can't kill threads and would just wait forever
 #ifndef __amigaos4__
 	SDL_WaitThread(musicThread, NULL);
+	if (decodeThread) {
+		SDL_WaitThread(decodeThread, NULL);
+	}
 #endif
 
 	for(int i =0; i<num_streams; i++) {
@@ -359,6 +398,11 @@ OpenALAudioDriver::~OpenALAudioDriver(void)
 	speech.ForceClear();
 	ResetMusics();
 	clearBufferCache(true);
+	logCacheStats();
+	Log(DEBUG, "OpenAL", "Music lock: %lu locks, waited %lums in total, %lums at most",
+		musicLockStats.locks, musicLockStats.waitTime, musicLockStats.maxWait);
+	pendingSounds.clear();
+	decodedSounds.clear();
 
 #ifdef HAVE_OPENAL_EFX_H
 	if (hasEFX) {
@@ -380,74 +424,173 @@ OpenALAudioDriver::~OpenALAudioDriver(void)
 
 	SDL_DestroyMutex(musicMutex);
 	musicMutex = NULL;
+	SDL_DestroyMutex(bufferMutex);
+	bufferMutex = NULL;
+	SDL_DestroySemaphore(decodeSem);
+	decodeSem = NULL;
 
 	free(music_memory);
 
 	delete ambim;
 }
 
-ALuint OpenALAudioDriver::loadSound(const char *ResRef, unsigned int &time_length)
+// the cache is case insensitive, like the resource lookup
+static std::string CacheKey(const char* ResRef)
 {
-	ALuint Buffer = 0;
+	std::string key(ResRef);
+	std::transform(key.begin(), key.end(), key.begin(), ::tolower);
+	return key;
+}
 
-	CacheEntry *e;
-	void* p;
+// the returned buffer is referenced, so it can't be evicted before it is queued
+// the caller has to releaseBuffer() it when done
+ALuint OpenALAudioDriver::findSound(const char* ResRef, unsigned int &time_length)
+{
+	StackLock l(bufferMutex, "bufferMutex in findSound()");
 
-	if (!ResRef[0]) {
+	std::map<std::string, CacheEntry*>::iterator it = buffercache.find(CacheKey(ResRef));
+	if (it == buffercache.end()) {
 		return 0;
 	}
-	if(buffercache.Lookup(ResRef, p))
-	{
-		e = (CacheEntry*) p;
-		time_length = e->Length;
-		return e->Buffer;
-	}
 
-	//no cache entry...
-	alGenBuffers(1, &Buffer);
-	if (checkALError("Unable to create sound buffer", ERROR)) {
+	CacheEntry* e = it->second;
+	bufferLRU.splice(bufferLRU.begin(), bufferLRU, e->lru);
+	cacheStats.hits++;
+	e->refcount++;
+	time_length = e->Length;
+	return e->Buffer;
+}
+
+ALuint OpenALAudioDriver::loadSound(const char *ResRef, unsigned int &time_length)
+{
+	if (!ResRef[0]) {
 		return 0;
 	}
 
-	ResourceHolder<SoundMgr> acm(ResRef);
-	if (!acm) {
-		alDeleteBuffers( 1, &Buffer );
-		checkALError("Unable to delete buffer!", ERROR);
-		return 0;
+	ALuint Buffer = findSound(ResRef, time_length);
+	if (Buffer) {
+		return Buffer;
 	}
+	return decodeSound(ResRef, time_length);
+}
+
+bool DecodedSound::Decode(SoundMgr* acm)
+{
+	unsigned long startTime = SDL_GetTicks();
+
 	int cnt = acm->get_length();
-	int riff_chans = acm->get_channels();
-	int samplerate = acm->get_samplerate();
+	channels = acm->get_channels();
+	samplerate = acm->get_samplerate();
+	if (cnt <= 0 || channels <= 0 || samplerate <= 0) {
+		return false;
+	}
 	//multiply always by 2 because it is in 16 bits
-	int rawsize = cnt * 2;
-	short* memory = (short*) malloc(rawsize);
+	memory = (short*) malloc(cnt * 2);
+	if (!memory) {
+		return false;
+	}
 	//multiply always with 2 because it is in 16 bits
-	int cnt1 = acm->read_samples( memory, cnt ) * 2;
+	size = acm->read_samples( memory, cnt ) * 2;
 	//Sound Length in milliseconds
-	time_length = ((cnt / riff_chans) * 1000) / samplerate;
-	//it is always reading the stuff into 16 bits
-	alBufferData( Buffer, GetFormatEnum( riff_chans, 16 ), memory, cnt1, samplerate );
-	free(memory);
+	length = ((cnt / channels) * 1000) / samplerate;
+	decodeTime = SDL_GetTicks() - startTime;
+	return true;
+}
+
+ALuint OpenALAudioDriver::decodeSound(const char* ResRef, unsigned int &time_length)
+{
+	ResourceHolder<SoundMgr> acm(ResRef);
+	if (!acm) {
+		return 0;
+	}
+
+	DecodedSound sound;
+	if (!sound.Decode(acm.get())) {
+		return 0;
+	}
+	return cacheSound(ResRef, sound, false, time_length);
+}
 
+// uploads the samples and adds them to the cache, the buffer is returned referenced
+// like with findSound
+ALuint OpenALAudioDriver::cacheSound(const std::string& ResRef, const DecodedSound& sound, bool async, unsigned int &time_length)
+{
+	ALuint Buffer = 0;
+
+	alGenBuffers(1, &Buffer);
+	if (checkALError("Unable to create sound buffer", ERROR)) {
+		return 0;
+	}
+
+	//it is always reading the stuff into 16 bits
+	alBufferData( Buffer, GetFormatEnum( sound.channels, 16 ), sound.memory, sound.size, sound.samplerate );
 	if (checkALError("Unable to fill buffer", ERROR)) {
 		alDeleteBuffers( 1, &Buffer );
 		checkALError("Error deleting buffer", WARNING);
 		return 0;
 	}
 
-	e = new CacheEntry;
-	e->Buffer = Buffer;
-	e->Length = ((cnt / riff_chans) * 1000) / samplerate;
+	StackLock l(bufferMutex, "bufferMutex in cacheSound()");
+	cacheStats.decodes++;
+	if (async) {
+		cacheStats.asyncDecodes++;
+	}
+	cacheStats.decodeTime += sound.decodeTime;
 
-	buffercache.SetAt(ResRef, (void*)e);
-	//print("LoadSound: added %s to cache: %d. Cache size now %d", ResRef, e->Buffer, buffercache.GetCount());
+	std::string key = CacheKey(ResRef.c_str());
+	std::map<std::string, CacheEntry*>::iterator it = buffercache.find(key);
+	if (it != buffercache.end()) {
+		// it was decoded twice, keep the first one
+		alDeleteBuffers( 1, &Buffer );
+		checkALError("Error deleting buffer", WARNING);
+		it->second->refcount++;
+		time_length = it->second->Length;
+		return it->second->Buffer;
+	}
 
-	if (buffercache.GetCount() > BUFFER_CACHE_SIZE) {
-		evictBuffer();
+	// make room first, so the new buffer can't be evicted right away
+	while (cacheStats.bytes + sound.size > BUFFER_CACHE_SIZE) {
+		if (!evictBuffer()) break;
 	}
+
+	CacheEntry* e = new CacheEntry;
+	e->Buffer = Buffer;
+	e->Length = sound.length;
+	e->Size = sound.size;
+	e->refcount = 1;
+	e->self = buffercache.insert(std::make_pair(key, e)).first;
+	cachedBuffers[Buffer] = e;
+	bufferLRU.push_front(e);
+	e->lru = bufferLRU.begin();
+	cacheStats.bytes += e->Size;
+	//print("LoadSound: added %s to cache: %d. Cache size now %d", ResRef, e->Buffer, buffercache.size());
+
+	time_length = e->Length;
 	return Buffer;
 }
 
+void OpenALAudioDriver::retainBuffer(ALuint buffer)
+{
+	StackLock l(bufferMutex, "bufferMutex in retainBuffer()");
+
+	std::map<ALuint, CacheEntry*>::iterator it = cachedBuffers.find(buffer);
+	if (it != cachedBuffers.end()) {
+		it->second->refcount++;
+	}
+}
+
+// buffers that aren't cached (movies) are ignored
+void OpenALAudioDriver::releaseBuffer(ALuint buffer)
+{
+	StackLock l(bufferMutex, "bufferMutex in releaseBuffer()");
+
+	std::map<ALuint, CacheEntry*>::iterator it = cachedBuffers.find(buffer);
+	if (it != cachedBuffers.end()) {
+		assert(it->second->refcount > 0);
+		it->second->refcount--;
+	}
+}
+
 Holder<SoundHandle> OpenALAudioDriver::Play(const char* ResRef, int XPos, int YPos, unsigned int flags, unsigned int *length)
 {
 	ALuint Buffer;
@@ -463,9 +606,22 @@ Holder<SoundHandle> OpenALAudioDriver::Play(const char* ResRef, int XPos, int YP
 		return Holder<SoundHandle>();
 	}
 
-	Buffer = loadSound( ResRef, time_length );
-	if (Buffer == 0) {
-		return Holder<SoundHandle>();
+	// nobody waits for the length of ordinary sounds, so they don't have to be decoded right away
+	// the resource is still opened here, only reading the samples is left to the decoder
+	Holder<SoundMgr> pending;
+	if (!length && !(flags & GEM_SND_SPEECH) && decodeThread && ResRef[0]) {
+		Buffer = findSound( ResRef, time_length );
+		if (!Buffer) {
+			pending = ResourceHolder<SoundMgr>(ResRef);
+			if (!pending) {
+				return Holder<SoundHandle>();
+			}
+		}
+	} else {
+		Buffer = loadSound( ResRef, time_length );
+		if (Buffer == 0) {
+			return Holder<SoundHandle>();
+		}
 	}
 
 	if (length) {
@@ -516,6 +672,7 @@ Holder<SoundHandle> OpenALAudioDriver::Play(const char* ResRef, int XPos, int YP
 		if (stream == NULL) {
 			// Failed to assign new sound.
 			// The buffercache will handle deleting Buffer.
+			releaseBuffer(Buffer);
 			return Holder<SoundHandle>();
 		}
 	}
@@ -526,6 +683,7 @@ Holder<SoundHandle> OpenALAudioDriver::Play(const char* ResRef, int XPos, int YP
 	if(!Source || !alIsSource(Source)) {
 		alGenSources( 1, &Source );
 		if (checkALError("Error creating source", ERROR)) {
+			releaseBuffer(Buffer);
 			return Holder<SoundHandle>();
 		}
 	}
@@ -555,8 +713,19 @@ Holder<SoundHandle> OpenALAudioDriver::Play(const char* ResRef, int XPos, int YP
 	stream->Source = Source;
 	stream->free = false;
 
-	if (QueueALBuffer(Source, Buffer) != GEM_OK) {
-		return Holder<SoundHandle>();
+	if (pending) {
+		// Update() starts it once the decoder is done
+		StackLock l(bufferMutex, "bufferMutex in Play()");
+		stream->pending = new PendingSound(ResRef, pending, Source, bufferMutex);
+		pendingSounds.push_back(stream->pending);
+		SDL_SemPost(decodeSem);
+	} else {
+		// queueing holds its own reference
+		int ret = QueueALBuffer(Source, Buffer);
+		releaseBuffer(Buffer);
+		if (ret != GEM_OK) {
+			return Holder<SoundHandle>();
+		}
 	}
 
 	stream->handle = new OpenALSoundHandle(stream);
@@ -568,7 +737,7 @@ void OpenALAudioDriver::UpdateVolume(unsigned int flags)
 	ieDword volume;
 
 	if (flags & GEM_SND_VOL_MUSIC) {
-		SDL_mutexP( musicMutex );
+		lockMusic();
 		core->GetDictionary()->Lookup("Volume Music", volume);
 		if (MusicSource && alIsSource(MusicSource))
 			alSourcef(MusicSource, AL_GAIN, volume * 0.01f);
@@ -589,7 +758,8 @@ bool OpenALAudioDriver::CanPlay()
 void OpenALAudioDriver::ResetMusics()
 {
 	MusicPlaying = false;
-	SDL_mutexP( musicMutex );
+	lockMusic();
+	musicGeneration++;
 	if (MusicSource && alIsSource(MusicSource)) {
 		alSourceStop(MusicSource);
 		checkALError("Unable to stop music source", WARNING);
@@ -610,7 +780,7 @@ bool OpenALAudioDriver::Play()
 {
 	if (!MusicReader) return false;
 
-	SDL_mutexP( musicMutex );
+	lockMusic();
 	if (!MusicPlaying)
 		MusicPlaying = true;
 	SDL_mutexV( musicMutex );
@@ -620,7 +790,7 @@ bool OpenALAudioDriver::Play()
 
 bool OpenALAudioDriver::Stop()
 {
-	SDL_mutexP( musicMutex );
+	lockMusic();
 	if (!MusicSource || !alIsSource( MusicSource )) {
 		SDL_mutexV( musicMutex );
 		return false;
@@ -631,13 +801,14 @@ bool OpenALAudioDriver::Stop()
 	alDeleteSources( 1, &MusicSource );
 	checkALError("Unable to delete music source", WARNING);
 	MusicSource = 0;
+	musicGeneration++;
 	SDL_mutexV( musicMutex );
 	return true;
 }
 
 bool OpenALAudioDriver::Pause()
 {
-	SDL_mutexP( musicMutex );
+	lockMusic();
 	if (!MusicSource || !alIsSource( MusicSource )) {
 		SDL_mutexV( musicMutex );
 		return false;
@@ -662,7 +833,7 @@ bool OpenALAudioDriver::Resume()
 	al_android_resume_playback(); //call AudioTrack.play() from JNI
 #endif
 #endif
-	SDL_mutexP( musicMutex );
+	lockMusic();
 	if (!MusicSource || !alIsSource( MusicSource )) {
 		SDL_mutexV( musicMutex );
 		return false;
@@ -677,9 +848,21 @@ bool OpenALAudioDriver::Resume()
 
 int OpenALAudioDriver::CreateStream(Holder<SoundMgr> newMusic)
 {
-	StackLock l(musicMutex, "musicMutex in CreateStream()");
+	lockMusic();
+	int ret = openMusicStream(newMusic);
+	SDL_mutexV(musicMutex);
+	return ret;
+}
 
-	// Free old MusicReader
+int OpenALAudioDriver::openMusicStream(Holder<SoundMgr> newMusic)
+{
+	// buffers the music thread decoded from the old reader must not get queued
+	musicGeneration++;
+	// Free old MusicReader, unless the music thread is still decoding from it
+	// (once one is parked, any later replacement was never touched by it)
+	if (musicDecoding && !retiredMusicReader) {
+		retiredMusicReader = MusicReader;
+	}
 	MusicReader = newMusic;
 	if (!MusicReader) {
 		MusicPlaying = false;
@@ -815,7 +998,9 @@ int OpenALAudioDriver::QueueAmbient(int stream, const char* sound)
 
 	assert(!streams[stream].delete_buffers);
 
-	if (QueueALBuffer(source, Buffer) != GEM_OK) {
+	int ret = QueueALBuffer(source, Buffer);
+	releaseBuffer(Buffer);
+	if (ret != GEM_OK) {
 		return GEM_ERROR;
 	}
 
@@ -846,51 +1031,56 @@ bool OpenALAudioDriver::evictBuffer()
 {
 	// Note: this function assumes the caller holds bufferMutex
 
-	// Room for optimization: this is O(n^2) in the number of buffers
-	// at the tail that are used. It can be O(n) if LRUCache supports it.
-
-	unsigned int n = 0;
-	void* p;
-	const char* k;
-	bool res;
-
-	while ((res = buffercache.getLRU(n, k, p)) == true) {
-		CacheEntry* e = (CacheEntry*)p;
-		alDeleteBuffers(1, &e->Buffer);
-		if (alGetError() == AL_NO_ERROR) {
-			// Buffer was unused. An error would have indicated
-			// the buffer was still attached to a source.
-
-			delete e;
-			buffercache.Remove(k);
-
-			//print("Removed buffer %s from ACMImp cache", k);
-			break;
+	// referenced buffers can't be deleted, they are moved to the front,
+	// so the next call doesn't have to look at them again
+	size_t tries = bufferLRU.size();
+	while (tries--) {
+		CacheEntry* e = bufferLRU.back();
+		if (e->refcount) {
+			bufferLRU.splice(bufferLRU.begin(), bufferLRU, e->lru);
+			continue;
 		}
-		++n;
+		alDeleteBuffers(1, &e->Buffer);
+		cacheStats.bytes -= e->Size;
+		cacheStats.evictions++;
+		bufferLRU.pop_back();
+		buffercache.erase(e->self);
+		cachedBuffers.erase(e->Buffer);
+		delete e;
+		return true;
 	}
 
-	return res;
+	return false;
 }
 
 void OpenALAudioDriver::clearBufferCache(bool force)
 {
-	// Room for optimization: any method of iterating over the buffers
-	// would suffice. It doesn't have to be in LRU-order.
-	void* p;
-	const char* k;
-	int n = 0;
-	while (buffercache.getLRU(n, k, p)) {
-		CacheEntry* e = (CacheEntry*)p;
-		alDeleteBuffers(1, &e->Buffer);
-		if (force || alGetError() == AL_NO_ERROR) {
+	StackLock l(bufferMutex, "bufferMutex in clearBufferCache()");
+
+	std::list<CacheEntry*>::iterator it = bufferLRU.begin();
+	while (it != bufferLRU.end()) {
+		CacheEntry* e = *it;
+		if (force || !e->refcount) {
+			alDeleteBuffers(1, &e->Buffer);
+			cacheStats.bytes -= e->Size;
+			buffercache.erase(e->self);
+			cachedBuffers.erase(e->Buffer);
 			delete e;
-			buffercache.Remove(k);
-		} else
-			++n;
+			it = bufferLRU.erase(it);
+		} else {
+			++it;
+		}
 	}
 }
 
+void OpenALAudioDriver::logCacheStats() const
+{
+	unsigned long lookups = cacheStats.hits + cacheStats.decodes;
+	Log(DEBUG, "OpenAL", "Sound cache: %lu lookups, %.1f%% hit rate, %lu decodes (%lu in the background) taking %lums on average, %lu evictions",
+		lookups, (lookups) ? 100.0 * cacheStats.hits / lookups : 0.0, cacheStats.decodes, cacheStats.asyncDecodes,
+		(cacheStats.decodes) ? cacheStats.decodeTime / cacheStats.decodes : 0, cacheStats.evictions);
+}
+
 ALenum OpenALAudioDriver::GetFormatEnum(int channels, int bits)
 {
 	switch (channels) {
@@ -911,15 +1101,102 @@ ALenum OpenALAudioDriver::GetFormatEnum(int channels, int bits)
 	return AL_FORMAT_MONO8;
 }
 
+// only reads the samples, uploading and queueing them is left to Update()
+// on the main thread, so nothing here touches OpenAL or logs
+int OpenALAudioDriver::DecodeManager(void* arg)
+{
+	OpenALAudioDriver* driver = (OpenALAudioDriver*) arg;
+	while (true) {
+		SDL_SemWait(driver->decodeSem);
+		if (!driver->stayAlive) break;
+
+		// only we remove from the list, so the front stays put while we are decoding
+		PendingSound* sound;
+		{
+			StackLock l(driver->bufferMutex, "bufferMutex in DecodeManager()");
+			if (driver->pendingSounds.empty()) continue;
+			sound = driver->pendingSounds.front().get();
+		}
+
+		// the samples stay empty if it fails, Update() reports it
+		sound->samples.Decode(sound->acm.get());
+
+		StackLock l(driver->bufferMutex, "bufferMutex in DecodeManager()");
+		driver->decodedSounds.push_back(driver->pendingSounds.front());
+		driver->pendingSounds.pop_front();
+	}
+	return 0;
+}
+
+void OpenALAudioDriver::Update()
+{
+	std::list<Holder<PendingSound> > decoded;
+	{
+		StackLock l(bufferMutex, "bufferMutex in Update()");
+		decoded.swap(decodedSounds);
+	}
+
+	std::list<Holder<PendingSound> >::iterator it;
+	for (it = decoded.begin(); it != decoded.end(); ++it) {
+		PendingSound* sound = it->get();
+		sound->acm.release();
+
+		unsigned int time_length;
+		ALuint Buffer = 0;
+		if (sound->samples.memory) {
+			Buffer = cacheSound(sound->ResRef, sound->samples, true, time_length);
+		} else {
+			Log(ERROR, "OpenAL", "Unable to decode %s", sound->ResRef.c_str());
+		}
+
+		ALuint Source;
+		{
+			StackLock l(bufferMutex, "bufferMutex in Update()");
+			Source = sound->Source;
+		}
+		if (Source && (!Buffer || QueueALBuffer(Source, Buffer) != GEM_OK)) {
+			// stopping it lets the stream be reclaimed as usual
+			alSourceStop(Source);
+			checkALError("Unable to stop source", WARNING);
+		}
+		releaseBuffer(Buffer);
+	}
+
+	// the sounds may still be referenced by their streams
+	StackLock l(bufferMutex, "bufferMutex in Update()");
+	decoded.clear();
+}
+
+void OpenALAudioDriver::lockMusic()
+{
+	unsigned long startTime = SDL_GetTicks();
+	SDL_mutexP(musicMutex);
+	unsigned long waited = SDL_GetTicks() - startTime;
+	musicLockStats.locks++;
+	musicLockStats.waitTime += waited;
+	if (waited > musicLockStats.maxWait) {
+		musicLockStats.maxWait = waited;
+	}
+}
+
 int OpenALAudioDriver::MusicManager(void* arg)
 {
 	OpenALAudioDriver* driver = (OpenALAudioDriver*) arg;
-	ALuint buffersreturned = 0;
 	ALboolean bFinished = AL_FALSE;
 	while (driver->stayAlive) {
 		SDL_Delay(30);
-		StackLock l(driver->musicMutex, "musicMutex in PlayListManager()");
-		if (driver->MusicPlaying) {
+
+		// only the quick AL calls happen with the lock held, decoding is done without it
+		ALuint buffers[MUSICBUFFERS];
+		int count = 0;
+		bool restart = false;
+		SoundMgr* reader;
+		unsigned int generation;
+		{
+			StackLock l(driver->musicMutex, "musicMutex in PlayListManager()");
+			if (!driver->MusicPlaying) {
+				continue;
+			}
 			ALint state;
 			alGetSourcei( driver->MusicSource, AL_SOURCE_STATE, &state );
 			if (checkALError("Unable to query music source state", ERROR)) {
@@ -934,34 +1211,14 @@ int OpenALAudioDriver::MusicManager(void* arg)
 					driver->MusicPlaying = false;
 					return -1;
 				case AL_INITIAL:
-					 {
-						Log(MESSAGE, "OPENAL", "Music in INITIAL State. AutoStarting");
-						// ensure that MusicSource has no buffers attached by passing "NULL" buffer
-						alSourcei(driver->MusicSource, AL_BUFFER, 0);
-						checkALError("Unable to detach buffers from music source.", WARNING);
-						for (int i = 0; i < MUSICBUFFERS; i++) {
-							driver->MusicReader->read_samples( driver->music_memory, ACM_BUFFERSIZE >> 1 );
-							alBufferData( driver->MusicBuffer[i], AL_FORMAT_STEREO16,
-								driver->music_memory, ACM_BUFFERSIZE,
-								driver->MusicReader->get_samplerate() );
-						}
-						checkALError("Unable to buffer data.", ERROR);
-						// FIXME: determine if we should error out if any data fails to buffer
-						alSourceQueueBuffers( driver->MusicSource, MUSICBUFFERS, driver->MusicBuffer );
-						if (!checkALError("Unable to queue buffer.", ERROR)) {
-							if (driver->MusicSource && alIsSource( driver->MusicSource )) {
-								alSourcePlay( driver->MusicSource );
-								if (!checkALError("Error playing music source", ERROR)) {
-									// no errors happened
-									bFinished = AL_FALSE;
-									break;
-								}
-							}
-						}
-						// if all had gone well we would have broken out
-						driver->MusicPlaying = false;
-						return -1;
-					}
+					Log(MESSAGE, "OPENAL", "Music in INITIAL State. AutoStarting");
+					// ensure that MusicSource has no buffers attached by passing "NULL" buffer
+					alSourcei(driver->MusicSource, AL_BUFFER, 0);
+					checkALError("Unable to detach buffers from music source.", WARNING);
+					memcpy(buffers, driver->MusicBuffer, sizeof(buffers));
+					count = MUSICBUFFERS;
+					restart = true;
+					bFinished = AL_FALSE;
 					break;
 				case AL_STOPPED:
 					Log(MESSAGE, "OpenAL", "WARNING: Buffer Underrun. AutoRestarting Stream Playback");
@@ -973,55 +1230,96 @@ int OpenALAudioDriver::MusicManager(void* arg)
 				case AL_PLAYING:
 					break;
 			}
-			ALint processed;
-			alGetSourcei( driver->MusicSource, AL_BUFFERS_PROCESSED, &processed );
-			if (checkALError("Unable to query music source state", ERROR)) {
-				driver->MusicPlaying = false;
-				return -1;
-			}
-			if (processed > 0) {
-				buffersreturned += processed;
-				while (processed) {
-					ALuint BufferID;
-					alSourceUnqueueBuffers( driver->MusicSource, 1, &BufferID );
+			if (!restart) {
+				ALint processed;
+				alGetSourcei( driver->MusicSource, AL_BUFFERS_PROCESSED, &processed );
+				if (checkALError("Unable to query music source state", ERROR)) {
+					driver->MusicPlaying = false;
+					return -1;
+				}
+				if (processed > 0) {
+					alSourceUnqueueBuffers( driver->MusicSource, processed, buffers );
 					if (checkALError("Unable to unqueue music buffers", ERROR)) {
 						driver->MusicPlaying = false;
 						return -1;
 					}
 					if (bFinished == AL_FALSE) {
-						int size = ACM_BUFFERSIZE;
-						int cnt = driver->MusicReader->read_samples( driver->music_memory, ACM_BUFFERSIZE >> 1 );
-						size -= ( cnt * 2 );
-						if (size != 0)
-							bFinished = AL_TRUE;
-						if (bFinished) {
-							Log(MESSAGE, "OpenAL", "Playing Next Music");
-							core->GetMusicMgr()->PlayNext();
-							if (driver->MusicPlaying) {
-								Log(MESSAGE, "OpenAL", "Queuing New Music");
-								driver->MusicReader->read_samples( ( driver->music_memory + cnt ), size >> 1 );
-								bFinished = AL_FALSE;
-							} else {
-								Log(MESSAGE, "OpenAL", "No Other Music to play");
-								memset( driver->music_memory + cnt, 0, size );
-								driver->MusicPlaying = false;
-								break;
-							}
-						}
-						alBufferData( BufferID, AL_FORMAT_STEREO16, driver->music_memory, ACM_BUFFERSIZE, driver->MusicReader->get_samplerate() );
-						if (checkALError("Unable to buffer music data", ERROR)) {
-							driver->MusicPlaying = false;
-							return -1;
-						}
-						alSourceQueueBuffers( driver->MusicSource, 1, &BufferID );
-						if (checkALError("Unable to queue music buffers", ERROR)) {
-							driver->MusicPlaying = false;
-							return -1;
-						}
-						processed--;
+						count = processed;
 					}
 				}
 			}
+			if (!count || !driver->MusicReader) {
+				continue;
+			}
+			reader = driver->MusicReader.get();
+			generation = driver->musicGeneration;
+			driver->musicDecoding = true;
+		}
+
+		// meanwhile the music may get stopped or switched, see CreateStream
+		int rates[MUSICBUFFERS];
+		int filled = 0;
+		while (filled < count) {
+			short* memory = driver->music_memory + filled * ( ACM_BUFFERSIZE >> 1 );
+			int size = ACM_BUFFERSIZE;
+			int cnt = reader->read_samples( memory, ACM_BUFFERSIZE >> 1 );
+			size -= ( cnt * 2 );
+			if (size != 0 && !restart) {
+				{
+					StackLock l(driver->musicMutex, "musicMutex in PlayListManager()");
+					if (generation != driver->musicGeneration || !driver->MusicPlaying) {
+						// stopped in the meantime, nothing more to queue
+						break;
+					}
+				}
+				Log(MESSAGE, "OpenAL", "Playing Next Music");
+				core->GetMusicMgr()->PlayNext();
+				{
+					StackLock l(driver->musicMutex, "musicMutex in PlayListManager()");
+					if (!driver->MusicPlaying || !driver->MusicReader) {
+						Log(MESSAGE, "OpenAL", "No Other Music to play");
+						driver->MusicPlaying = false;
+						bFinished = AL_TRUE;
+						break;
+					}
+					// the previous reader has been used up
+					driver->retiredMusicReader.release();
+					reader = driver->MusicReader.get();
+					generation = driver->musicGeneration;
+				}
+				Log(MESSAGE, "OpenAL", "Queuing New Music");
+				reader->read_samples( ( memory + cnt ), size >> 1 );
+			}
+			rates[filled] = reader->get_samplerate();
+			filled++;
+		}
+
+		StackLock l(driver->musicMutex, "musicMutex in PlayListManager()");
+		driver->musicDecoding = false;
+		driver->retiredMusicReader.release();
+		if (generation != driver->musicGeneration || !filled) {
+			// the source is gone together with its queue, so the buffers are free anyway
+			continue;
+		}
+		for (int i = 0; i < filled; i++) {
+			alBufferData( buffers[i], AL_FORMAT_STEREO16, driver->music_memory + i * ( ACM_BUFFERSIZE >> 1 ),
+				ACM_BUFFERSIZE, rates[i] );
+			if (checkALError("Unable to buffer music data", ERROR)) {
+				driver->MusicPlaying = false;
+				return -1;
+			}
+		}
+		alSourceQueueBuffers( driver->MusicSource, filled, buffers );
+		if (checkALError("Unable to queue music buffers", ERROR)) {
+			driver->MusicPlaying = false;
+			return -1;
+		}
+		if (restart) {
+			alSourcePlay( driver->MusicSource );
+			if (checkALError("Error playing music source", ERROR)) {
+				driver->MusicPlaying = false;
+				return -1;
+			}
 		}
 	}
 	return 0;
@@ -1075,6 +1373,8 @@ int OpenALAudioDriver::QueueALBuffer(ALuint source, ALuint buffer)
 	if (checkALError("Unable to queue buffer", ERROR)) {
 		return GEM_ERROR;
 	}
+	// until it is unqueued in ClearProcessedBuffers
+	retainBuffer(buffer);
 
 	ALenum state;
 	alGetSourcei(source, AL_SOURCE_STATE, &state);
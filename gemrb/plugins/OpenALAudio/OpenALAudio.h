@@ -28,13 +28,16 @@
 
 #include "ie_types.h"
 
-#include "LRUCache.h"
 #include "MusicMgr.h"
 #include "SoundMgr.h"
 #include "System/FileStream.h"
 #include "MapReverb.h"
 
 #include <SDL.h>
+#include <cstdlib>
+#include <list>
+#include <map>
+#include <string>
 
 #ifndef WIN32
 #ifdef __APPLE_CC__
@@ -64,7 +67,7 @@
 #endif
 
 #define RETRY 5
-#define BUFFER_CACHE_SIZE 100
+#define BUFFER_CACHE_SIZE (32*1024*1024) // bytes of decoded samples kept around
 #define MAX_STREAMS 30
 #define MUSICBUFFERS 10
 #define REFERENCE_DISTANCE 50
@@ -88,9 +91,44 @@ public:
 	void Invalidate() { parent = 0; }
 };
 
+// 16 bit samples read from a SoundMgr, not yet handed to OpenAL
+struct DecodedSound {
+	DecodedSound() : memory(NULL), size(0), channels(0), samplerate(0), length(0), decodeTime(0) { }
+	~DecodedSound() { free(memory); }
+
+	short* memory;
+	int size; // bytes
+	int channels;
+	int samplerate;
+	unsigned int length; // ms
+	unsigned long decodeTime; // ms
+
+	// no OpenAL calls and no logging, so it is safe on any thread
+	bool Decode(SoundMgr* acm);
+};
+
+// a sound that is played once the decoder thread has read it and the main thread
+// has uploaded it in Update(). The reader is opened on the main thread and released
+// there too, in between only the decoder touches it and the samples.
+// The holder itself is shared between the stream and the decoder, so it may only be
+// copied or released with 'mutex' held
+struct PendingSound : public Held<PendingSound> {
+	PendingSound(const char* ResRef, Holder<SoundMgr> acm, ALuint Source, SDL_mutex* mutex)
+		: ResRef(ResRef), acm(acm), Source(Source), mutex(mutex) { }
+
+	std::string ResRef;
+	Holder<SoundMgr> acm;
+	DecodedSound samples;
+	ALuint Source; // 0 once the stream gave up on it
+	SDL_mutex* mutex;
+};
+
+class OpenALAudioDriver;
+
 struct AudioStream {
-	AudioStream() : Buffer(0), Source(0), Duration(0), free(true), ambient(false), locked(false), delete_buffers(false) { }
+	AudioStream() : driver(NULL), Buffer(0), Source(0), Duration(0), free(true), ambient(false), locked(false), delete_buffers(false) { }
 
+	OpenALAudioDriver* driver; // to give unqueued buffers back to the cache
 	ALuint Buffer;
 	ALuint Source;
 	int Duration;
@@ -102,13 +140,37 @@ struct AudioStream {
 	void ClearIfStopped();
 	void ClearProcessedBuffers();
 	void ForceClear();
+	void CancelPending();
 
 	Holder<OpenALSoundHandle> handle;
+	Holder<PendingSound> pending;
 };
 
 struct CacheEntry {
 	ALuint Buffer;
 	unsigned int Length;
+	unsigned int Size; // bytes
+	// sources the buffer is queued on, plus callers that just looked it up
+	// only unreferenced buffers may be evicted
+	unsigned int refcount;
+	std::list<CacheEntry*>::iterator lru;
+	std::map<std::string, CacheEntry*>::iterator self;
+};
+
+struct BufferCacheStats {
+	unsigned long hits;
+	unsigned long decodes; // every decode is a miss
+	unsigned long asyncDecodes;
+	unsigned long decodeTime; // ms spent in all decodes
+	unsigned long evictions;
+	size_t bytes;
+};
+
+// how long the other threads had to wait for the music thread
+struct MusicLockStats {
+	unsigned long locks;
+	unsigned long waitTime; // ms
+	unsigned long maxWait; // ms
 };
 
 class OpenALAudioDriver : public Audio {
@@ -139,6 +201,8 @@ public:
 				int channels, short* memory,
 				int size, int samplerate);
 	void UpdateMapAmbient(MapReverb&);
+	void Update();
+	void releaseBuffer(ALuint buffer);
 private:
 	int QueueALBuffer(ALuint source, ALuint buffer);
 
@@ -149,20 +213,45 @@ private:
 	SDL_mutex* musicMutex;
 	ALuint MusicBuffer[MUSICBUFFERS];
 	Holder<SoundMgr> MusicReader;
-	LRUCache buffercache;
+	// the music thread decodes without holding musicMutex, so a reader replaced meanwhile
+	// is parked here until it is done with it
+	Holder<SoundMgr> retiredMusicReader;
+	bool musicDecoding;
+	unsigned int musicGeneration; // bumped whenever the music source goes away or its reader is replaced
+	MusicLockStats musicLockStats;
+	void lockMusic();
+	int openMusicStream(Holder<SoundMgr> newMusic);
+	// decoded sounds by lowercase resref, least recently used at the back
+	std::map<std::string, CacheEntry*> buffercache;
+	std::list<CacheEntry*> bufferLRU;
+	std::map<ALuint, CacheEntry*> cachedBuffers; // the same entries by buffer, for releaseBuffer
+	BufferCacheStats cacheStats;
+	SDL_mutex* bufferMutex; // guards the cache and the pending sounds
 	AudioStream speech;
 	AudioStream streams[MAX_STREAMS];
 	ALuint loadSound(const char* ResRef, unsigned int &time_length);
+	ALuint findSound(const char* ResRef, unsigned int &time_length);
+	ALuint decodeSound(const char* ResRef, unsigned int &time_length);
+	ALuint cacheSound(const std::string& ResRef, const DecodedSound& sound, bool async, unsigned int &time_length);
+	void retainBuffer(ALuint buffer);
 	int num_streams;
 	int CountAvailableSources(int limit);
 	bool evictBuffer();
 	void clearBufferCache(bool force);
+	void logCacheStats() const;
 	ALenum GetFormatEnum(int channels, int bits);
 	static int MusicManager(void* args);
 	bool stayAlive;
-	short* music_memory;
+	short* music_memory; // MUSICBUFFERS chunks of ACM_BUFFERSIZE bytes, filled before they are queued
 	SDL_Thread* musicThread;
 
+	// sounds that only have to be played, not measured, are decoded off the main thread
+	std::list<Holder<PendingSound> > pendingSounds;
+	std::list<Holder<PendingSound> > decodedSounds; // waiting for Update()
+	SDL_sem* decodeSem;
+	SDL_Thread* decodeThread;
+	static int DecodeManager(void* args);
+
 	bool InitEFX(void);
 	bool hasReverbProperties;
 
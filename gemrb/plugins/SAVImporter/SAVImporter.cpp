@@ -24,6 +24,10 @@
 #include "FileCache.h"
 #include "Interface.h"
 #include "PluginMgr.h"
+#include "System/MemoryStream.h"
+
+#include <string>
+#include <vector>
 
 using namespace GemRB;
 
@@ -35,36 +39,67 @@ SAVImporter::~SAVImporter()
 {
 }
 
-int SAVImporter::DecompressSaveGame(DataStream *compressed)
+//keep the whole archive in memory, the save slot may be overwritten while members are pending
+static MemoryStream* ReadArchive(DataStream *compressed)
 {
 	char Signature[8];
 	compressed->Read( Signature, 8 );
 	if (strncmp( Signature, "SAV V1.0", 8 ) ) {
-		return GEM_ERROR;
+		return NULL;
 	}
-	int All = compressed->Remains();
-	int Current;
+	unsigned long All = compressed->Remains();
+	if (!All) return NULL;
+
+	void* data = malloc(All);
+	if (compressed->Read(data, All) != (int) All) {
+		free(data);
+		return NULL;
+	}
+	return new MemoryStream(compressed->originalfile, data, All);
+}
+
+//areas and stores are only indexed here, they get unpacked when first requested
+//(late saves contain hundreds of areas, most of which are never visited again)
+int SAVImporter::DecompressSaveGame(DataStream *compressed)
+{
+	MemoryStream* archive = ReadArchive(compressed);
+	if (!archive) return GEM_ERROR;
+	SetDeferredArchive(archive);
+	unsigned long All = archive->Size();
+
+	unsigned long Current;
 	int percent, last_percent = 20;
-	if (!All) return GEM_ERROR;
+	int deferred = 0, unpacked = 0;
 	do {
 		ieDword fnlen, complen, declen;
-		compressed->ReadDword( &fnlen );
-		if (!fnlen) {
+		archive->ReadDword( &fnlen );
+		if (!fnlen || fnlen > archive->Remains()) {
 			Log(ERROR, "SAVImporter", "Corrupt Save Detected");
+			SetDeferredArchive(NULL);
 			return GEM_ERROR;
 		}
 		char* fname = ( char* ) malloc( fnlen );
-		compressed->Read( fname, fnlen );
+		archive->Read( fname, fnlen );
+		fname[fnlen-1] = 0;
 		strlwr(fname);
-		compressed->ReadDword( &declen );
-		compressed->ReadDword( &complen );
-		print("Decompressing %s", fname);
-		DataStream* cached = CacheCompressedStream(compressed, fname, complen, true);
+		archive->ReadDword( &declen );
+		archive->ReadDword( &complen );
+		if (core->SavedExtension(fname) == 2) {
+			DeferCompressedStream(fname, declen, complen);
+			deferred++;
+		} else {
+			print("Decompressing %s", fname);
+			DataStream* cached = CacheCompressedStream(archive, fname, complen, true);
+			if (!cached) {
+				free( fname );
+				SetDeferredArchive(NULL);
+				return GEM_ERROR;
+			}
+			delete cached;
+			unpacked++;
+		}
 		free( fname );
-		if (!cached)
-			return GEM_ERROR;
-		delete cached;
-		Current = compressed->Remains();
+		Current = archive->Remains();
 		//starting at 20% going up to 70%
 		percent = (20 + (All - Current) * 50 / All);
 		if (percent - last_percent > 5) {
@@ -73,6 +108,60 @@ int SAVImporter::DecompressSaveGame(DataStream *compressed)
 		}
 	}
 	while(Current);
+	Log(MESSAGE, "SAVImporter", "Unpacked %d files, %d more are unpacked on demand.", unpacked, deferred);
+	return GEM_OK;
+}
+
+struct SAVMember {
+	std::string name;
+	unsigned long offset;
+	ieDword declen, complen;
+	bool pending;
+};
+
+int SAVImporter::ReindexSaveGame(DataStream *compressed)
+{
+	MemoryStream* archive = ReadArchive(compressed);
+	if (!archive) return GEM_ERROR;
+
+	//collect everything first, the old index stays in use if this fails
+	std::vector<SAVMember> members;
+	while (archive->Remains()) {
+		ieDword fnlen, complen, declen;
+		archive->ReadDword( &fnlen );
+		if (!fnlen || fnlen > archive->Remains()) {
+			delete archive;
+			return GEM_ERROR;
+		}
+		char* fname = ( char* ) malloc( fnlen );
+		archive->Read( fname, fnlen );
+		fname[fnlen-1] = 0;
+		strlwr(fname);
+		archive->ReadDword( &declen );
+		archive->ReadDword( &complen );
+		if (core->SavedExtension(fname) == 2) {
+			SAVMember member;
+			member.name = fname;
+			member.offset = archive->GetPos();
+			member.declen = declen;
+			member.complen = complen;
+			//everything written from the cache is identical to it now
+			member.pending = IsDeferredStreamPending(fname);
+			members.push_back(member);
+		}
+		free( fname );
+		if (archive->Seek(complen, GEM_CURRENT_POS) != GEM_OK) {
+			delete archive;
+			return GEM_ERROR;
+		}
+	}
+
+	SetDeferredArchive(archive);
+	for (size_t i = 0; i < members.size(); i++) {
+		const SAVMember& member = members[i];
+		archive->Seek(member.offset, GEM_STREAM_START);
+		DeferCompressedStream(member.name.c_str(), member.declen, member.complen, !member.pending);
+	}
 	return GEM_OK;
 }
 
@@ -117,6 +206,28 @@ int SAVImporter::AddToSaveGame(DataStream *str, DataStream *uncompressed)
 	return GEM_OK;
 }
 
+int SAVImporter::AddCompressedToSaveGame(DataStream *str, const char *fname, ieDword declen, DataStream *compressed, ieDword complen)
+{
+	ieDword fnlen = strlen(fname)+1;
+	str->WriteDword( &fnlen);
+	str->Write( fname, fnlen);
+	str->WriteDword( &declen);
+	str->WriteDword( &complen);
+
+	char buffer[8192];
+	while (complen) {
+		ieDword chunk = complen < sizeof(buffer) ? complen : sizeof(buffer);
+		if (compressed->Read(buffer, chunk) != (int) chunk) {
+			return GEM_ERROR;
+		}
+		if (str->Write(buffer, chunk) != (int) chunk) {
+			return GEM_ERROR;
+		}
+		complen -= chunk;
+	}
+	return GEM_OK;
+}
+
 #include "plugindef.h"
 
 GEMRB_PLUGIN(0xCDF132C, "SAV File Importer")
@@ -34,7 +34,9 @@ public:
 	SAVImporter(void);
 	~SAVImporter(void);
 	int DecompressSaveGame(DataStream *compressed);
+	int ReindexSaveGame(DataStream *compressed);
 	int AddToSaveGame(DataStream *str, DataStream *uncompressed);
+	int AddCompressedToSaveGame(DataStream *str, const char *fname, ieDword declen, DataStream *compressed, ieDword complen);
 	int CreateArchive(DataStream *compressed);
 };
 
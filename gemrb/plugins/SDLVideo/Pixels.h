@@ -544,7 +544,9 @@ static void BlitBlendedRect(SDL_Surface* src, SDL_Surface* dst,
 	assert(srcrgn.h == dstrgn.h && srcrgn.w == dstrgn.w);
 
 	SDL_LockSurface(src);
-	SDL_LockSurface(dst);
+	// the destination may be shared by several tile rendering threads, so avoid touching its lock count needlessly
+	bool lockDst = SDL_MUSTLOCK(dst);
+	if (lockDst) SDL_LockSurface(dst);
 
 	SDLPixelIterator::Direction xdir = (flags&BLIT_MIRRORX) ? SDLPixelIterator::Reverse : SDLPixelIterator::Forward;
 	SDLPixelIterator::Direction ydir = (flags&BLIT_MIRRORY) ? SDLPixelIterator::Reverse : SDLPixelIterator::Forward;
@@ -563,7 +565,7 @@ static void BlitBlendedRect(SDL_Surface* src, SDL_Surface* dst,
 		Blit(srcbeg, dstbeg, dstend, alpha, blender);
 	}
 
-	SDL_UnlockSurface(dst);
+	if (lockDst) SDL_UnlockSurface(dst);
 	SDL_UnlockSurface(src);
 }
 
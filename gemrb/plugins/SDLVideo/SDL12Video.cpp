@@ -33,6 +33,20 @@ SDL12VideoDriver::SDL12VideoDriver(void)
 {
 	disp = NULL;
 	inTextInput = false;
+	tileBandsDone = NULL;
+	tileWorkersQuit = false;
+	for (int i = 0; i < TILE_RENDER_THREADS; i++) {
+		tileBands[i].driver = this;
+		tileBands[i].thread = NULL;
+		tileBands[i].start = NULL;
+		tileBands[i].begin = tileBands[i].end = NULL;
+	}
+}
+
+SDL12VideoDriver::~SDL12VideoDriver()
+{
+	StopTileWorkers();
+	spriteCache.LogStats();
 }
 
 int SDL12VideoDriver::Init(void)
@@ -169,7 +183,19 @@ void SDL12VideoDriver::BlitSpriteBAMClipped(const Sprite2D* spr, const Sprite2D*
 
 	// TODO: we technically only need SRBlender_Alpha when there is a mask. Could boost performance noticably to account for that.
 
-	if (remflags == BLIT_TINTED) {
+	const Uint32* expanded = NULL;
+	if (spr->RLE && SpriteCache::CanCache(remflags, mask != NULL)) {
+		expanded = spriteCache.Lookup(spr, palette, remflags, tint);
+	}
+
+	if (expanded) {
+
+		SRTinter_NoTint<true> tinter;
+		SRBlender_Alpha blender;
+
+		BlitSpriteRGB_dispatch(mask, hflip, currentBuf, expanded, x, y, w, h, vflip, dst, mask, spr, remflags, tinter, blender);
+
+	} else if (remflags == BLIT_TINTED) {
 
 		SRShadow_Regular shadow;
 		SRTinter_Tint<false, false> tinter(tint);
@@ -263,6 +289,117 @@ void SDL12VideoDriver::BlitSpriteBAMClipped(const Sprite2D* spr, const Sprite2D*
 	SDL_UnlockSurface(currentBuf);
 }
 
+void SDL12VideoDriver::StartTileWorkers()
+{
+	tileBandsDone = SDL_CreateSemaphore(0);
+	// band 0 is always drawn by the calling thread
+	for (int i = 1; i < TILE_RENDER_THREADS; i++) {
+		tileBands[i].start = SDL_CreateSemaphore(0);
+		tileBands[i].thread = SDL_CreateThread(TileWorker, &tileBands[i]);
+		if (!tileBands[i].thread) {
+			Log(WARNING, "SDL 1.2 Driver", "Unable to create tile rendering thread: %s", SDL_GetError());
+		}
+	}
+}
+
+void SDL12VideoDriver::StopTileWorkers()
+{
+	if (!tileBandsDone) return;
+
+	tileWorkersQuit = true;
+	for (int i = 1; i < TILE_RENDER_THREADS; i++) {
+		if (tileBands[i].thread) {
+			SDL_SemPost(tileBands[i].start);
+			SDL_WaitThread(tileBands[i].thread, NULL);
+			tileBands[i].thread = NULL;
+		}
+		SDL_DestroySemaphore(tileBands[i].start);
+		tileBands[i].start = NULL;
+	}
+	SDL_DestroySemaphore(tileBandsDone);
+	tileBandsDone = NULL;
+}
+
+int SDL12VideoDriver::TileWorker(void* data)
+{
+	TileBand* band = static_cast<TileBand*>(data);
+	SDL12VideoDriver* driver = band->driver;
+
+	while (true) {
+		SDL_SemWait(band->start);
+		if (driver->tileWorkersQuit) break;
+		driver->BlitTileBand(band->begin, band->end);
+		SDL_SemPost(driver->tileBandsDone);
+	}
+	return 0;
+}
+
+void SDL12VideoDriver::BlitTileBand(const TileBlit* begin, const TileBlit* end)
+{
+	for (; begin != end; ++begin) {
+		BlitTile(begin->spr, begin->mask, begin->x, begin->y, NULL, begin->flags);
+	}
+}
+
+void SDL12VideoDriver::BlitTiles(const std::vector<TileBlit>& tiles)
+{
+	if (tiles.empty()) return;
+
+	// count the rows, bands are made of whole rows so no two threads touch the same pixels or sprites
+	std::vector<size_t> rowStarts;
+	for (size_t i = 0; i < tiles.size(); i++) {
+		if (i == 0 || tiles[i].y != tiles[i-1].y) {
+			rowStarts.push_back(i);
+		}
+	}
+	int bandCount = std::min<int>(TILE_RENDER_THREADS, rowStarts.size());
+	// surfaces that need locking can't be shared between threads
+	if (bandCount < 2 || SDL_MUSTLOCK(CurrentRenderBuffer())) {
+		Video::BlitTiles(tiles);
+		return;
+	}
+
+	if (!tileBandsDone) {
+		StartTileWorkers();
+	}
+
+	const TileBlit* first = &tiles[0];
+	int started = 0;
+	for (int i = 0; i < bandCount; i++) {
+		size_t row = rowStarts.size() * i / bandCount;
+		size_t nextRow = rowStarts.size() * (i + 1) / bandCount;
+		tileBands[i].begin = first + rowStarts[row];
+		tileBands[i].end = (nextRow < rowStarts.size()) ? first + rowStarts[nextRow] : first + tiles.size();
+		if (i && tileBands[i].thread) {
+			SDL_SemPost(tileBands[i].start);
+			started++;
+		}
+	}
+
+	BlitTileBand(tileBands[0].begin, tileBands[0].end);
+	// bands without a thread (creation failed) are drawn here too
+	for (int i = 1; i < bandCount; i++) {
+		if (!tileBands[i].thread) {
+			BlitTileBand(tileBands[i].begin, tileBands[i].end);
+		}
+	}
+	// wait for everyone before anything else gets drawn on top
+	while (started--) {
+		SDL_SemWait(tileBandsDone);
+	}
+}
+
+void SDL12VideoDriver::BlitVideoBuffer(VideoBuffer* buf, const Point& p)
+{
+	Region dst = ClippedDrawingRect(Region(p, buf->Size()));
+	if (dst.Dimensions().IsEmpty()) return;
+
+	SDL_Surface* surf = static_cast<SDLSurfaceVideoBuffer*>(buf)->Surface();
+	SDL_Rect srect = RectFromRegion(Region(dst.Origin() - p, dst.Dimensions()));
+	SDL_Rect drect = RectFromRegion(dst);
+	BlitSurfaceClipped(surf, srect, drect);
+}
+
 void SDL12VideoDriver::BlitSurfaceClipped(SDL_Surface* surf, SDL_Rect& srect, SDL_Rect& drect)
 {
 	// since we should already be clipped we can call SDL_LowerBlit directly
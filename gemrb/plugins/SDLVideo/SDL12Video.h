@@ -22,16 +22,34 @@
 #define SDL12VIDEODRIVER_H
 
 #include "SDLVideo.h"
+#include "SpriteCache.h"
 
 namespace GemRB {
 
+// tile layers are split into this many horizontal bands, one of them drawn by the calling thread
+#define TILE_RENDER_THREADS 4
+
 class SDL12VideoDriver : public SDLVideoDriver {
 private:
+	struct TileBand {
+		SDL12VideoDriver* driver;
+		SDL_Thread* thread;
+		SDL_sem* start;
+		const TileBlit* begin;
+		const TileBlit* end;
+	};
+
 	SDL_Surface* disp;
 	bool inTextInput;
+	SpriteCache spriteCache;
+
+	TileBand tileBands[TILE_RENDER_THREADS];
+	SDL_sem* tileBandsDone;
+	bool tileWorkersQuit;
 
 public:
 	SDL12VideoDriver(void);
+	~SDL12VideoDriver();
 	
 	int Init(void);
 	int CreateDriverDisplay(const Size&, int bpp, const char* title);
@@ -49,6 +67,8 @@ public:
 	void SetGamma(int brightness, int contrast);
 
 	bool SupportsBAMSprites() { return true; }
+	void BlitTiles(const std::vector<TileBlit>& tiles);
+	void BlitVideoBuffer(VideoBuffer* buf, const Point& p);
 
 	void DrawLine(const Point& p1, const Point& p2, const Color& color);
 	void DrawLines(const std::vector<Point>& points, const Color& color);
@@ -80,6 +100,11 @@ private:
 								 unsigned int flags = 0, const SDL_Color* tint = NULL);
 
 	void BlitSurfaceClipped(SDL_Surface* surf, SDL_Rect& srect, SDL_Rect& drect);
+
+	void StartTileWorkers();
+	void StopTileWorkers();
+	void BlitTileBand(const TileBlit* begin, const TileBlit* end);
+	static int TileWorker(void* data);
 };
 
 class SDLSurfaceVideoBuffer : public VideoBuffer {
@@ -206,8 +231,14 @@ public:
 			if (strides[plane] < size) {
 				size = strides[plane];
 			}
+			int rows = (plane == 0) ? bufDest.h : (bufDest.h / 2);
+			if (strides[plane] == overlay->pitches[plane]) {
+				// same layout, so the plane is one contiguous block
+				memcpy(overlay->pixels[plane], data, strides[plane] * rows);
+				continue;
+			}
 			unsigned int srcoffset = 0, destoffset = 0;
-			for (int i = 0; i < ((plane == 0) ? bufDest.h : (bufDest.h / 2)); i++) {
+			for (int i = 0; i < rows; i++) {
 				memcpy(overlay->pixels[plane] + destoffset,
 					   data + srcoffset, size);
 				srcoffset += strides[plane];
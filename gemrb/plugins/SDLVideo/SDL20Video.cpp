@@ -78,7 +78,12 @@ VideoBuffer* SDL20VideoDriver::NewVideoBuffer(const Region& r, BufferFormat fmt)
 	if (format == SDL_PIXELFORMAT_UNKNOWN)
 		return NULL;
 	
-	SDL_Texture* tex = SDL_CreateTexture(renderer, format, SDL_TEXTUREACCESS_TARGET, r.w, r.h);
+	// the movie formats are only ever filled by CopyPixels, once per frame, so let the driver stream them
+	int access = SDL_TEXTUREACCESS_TARGET;
+	if (fmt == YV12 || fmt == RGB555 || fmt == RGBPAL8) {
+		access = SDL_TEXTUREACCESS_STREAMING;
+	}
+	SDL_Texture* tex = SDL_CreateTexture(renderer, format, access, r.w, r.h);
 	if (format == RGBA8888)
 		SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
 
@@ -270,6 +275,20 @@ void SDL20VideoDriver::DrawRect(const Region& rgn, const Color& color, bool fill
 	}
 }
 
+void SDL20VideoDriver::BlitVideoBuffer(VideoBuffer* buf, const Point& p)
+{
+	Region dst = ClippedDrawingRect(Region(p, buf->Size()));
+	if (dst.Dimensions().IsEmpty()) return;
+
+	UpdateRenderTarget();
+	SDL_Texture* tex = static_cast<SDLTextureVideoBuffer*>(buf)->GetTexture();
+	SDL_Rect srect = RectFromRegion(Region(dst.Origin() - p, dst.Dimensions()));
+	SDL_Rect drect = RectFromRegion(dst);
+	// RenderOnDisplay sets it back to blending
+	SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_NONE);
+	SDL_RenderCopy(renderer, tex, &srect, &drect);
+}
+
 Sprite2D* SDL20VideoDriver::GetScreenshot( Region r )
 {
 	SDL_Rect rect = RectFromRegion(r);
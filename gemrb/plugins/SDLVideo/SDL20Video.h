@@ -83,6 +83,7 @@ public:
 	void DrawLines(const std::vector<Point>& points, const Color& color);
 
 	void DrawRect(const Region& rgn, const Color& color, bool fill = true);
+	void BlitVideoBuffer(VideoBuffer* buf, const Point& p);
 	
 	void DrawPoint(const Point& p, const Color& color);
 	void DrawPoints(const std::vector<Point>& points, const Color& color);
@@ -115,11 +116,19 @@ class SDLTextureVideoBuffer : public VideoBuffer {
 	 // the format of the pixel data the client thinks we use, we may have to convert in CopyPixels()
 	Uint32 inputFormat; // the SDL pixel format equivalent of the requested Video::BufferFormat
 	Uint32 nativeFormat; // the SDL pixel format of the texture
+	// streaming textures (movie frames) are written through SDL_LockTexture, so conversions go straight into the driver memory
+	bool streaming;
+	SDL_PixelFormat* pxfmt; // for converting palettized input
 
-	// if the inputFormat is different than the actual texture format we will allocate a buffer to handle conversion
+	// if the inputFormat is different than the actual texture format and we can't write into the texture directly
+	// we will allocate a buffer to handle conversion
 	// this has significant memory overhead, but is much faster than dynamic allocation every frame
 	void* conversionBuffer;
 
+	// bytes of every CopyPixels, going through a buffer of ours and then handed to SDL
+	unsigned long frames;
+	double stagedBytes, uploadedBytes;
+
 private:
 	static Region TextureRegion(SDL_Texture* tex, const Point& p) {
 		int w, h;
@@ -127,6 +136,27 @@ private:
 		return Region(p, ::GemRB::Size(w, h));
 	}
 
+	void* ConversionBuffer() {
+		if (conversionBuffer == NULL) {
+			conversionBuffer = operator new(SDL_BYTESPERPIXEL(nativeFormat) * rect.w * rect.h);
+		}
+		return conversionBuffer;
+	}
+
+	void ConvertPalettized(const Uint8* src, const Palette* pal, int w, int h, Uint8* dst, int dstPitch) {
+		bool hasalpha = SDL_ISPIXELFORMAT_ALPHA(nativeFormat);
+		for (int y = 0; y < h; ++y) {
+			Uint32* px = reinterpret_cast<Uint32*>(dst + y * dstPitch);
+			for (int x = 0; x < w; ++x) {
+				const Color& c = pal->col[*src++];
+				*px++ = (c.r << pxfmt->Rshift) | (c.g << pxfmt->Gshift) | (c.b << pxfmt->Bshift) | (c.a << pxfmt->Ashift);
+				if (hasalpha == false) {
+					px = (Uint32*)((Uint8*)px - 1);
+				}
+			}
+		}
+	}
+
 public:
 	SDLTextureVideoBuffer(const Point& p, SDL_Texture* texture, Video::BufferFormat fmt, SDL_Renderer* renderer)
 	: VideoBuffer(TextureRegion(texture, p)), texture(texture), renderer(renderer), inputFormat(SDLPixelFormatFromBufferFormat(fmt, NULL))
@@ -134,27 +164,61 @@ public:
 		assert(texture);
 		assert(renderer);
 		maskLayer = NULL;
+		conversionBuffer = NULL;
+		pxfmt = NULL;
+		frames = 0;
+		stagedBytes = uploadedBytes = 0;
 
-		SDL_QueryTexture(texture, &nativeFormat, NULL, NULL, NULL);
+		int access;
+		SDL_QueryTexture(texture, &nativeFormat, &access, NULL, NULL);
+		streaming = (access == SDL_TEXTUREACCESS_STREAMING);
 
-		if (inputFormat != nativeFormat) {
-			conversionBuffer = operator new(SDL_BYTESPERPIXEL(nativeFormat) * rect.w * rect.h);
-		} else {
-			conversionBuffer = NULL;
+		if (inputFormat == SDL_PIXELFORMAT_INDEX8) {
+			pxfmt = SDL_AllocFormat(nativeFormat);
+		}
+		// 24 bit pixels are written as overlapping 32 bit words, which would run past the end of a locked texture
+		if (inputFormat != nativeFormat && (!streaming || SDL_BYTESPERPIXEL(nativeFormat) != 4)) {
+			ConversionBuffer();
 		}
 
 		Clear();
 	}
 
 	~SDLTextureVideoBuffer() {
+		if (frames) {
+			Log(DEBUG, "SDL20Video", "%lu frames, %.0f bytes staged and %.0f bytes uploaded per frame",
+				frames, stagedBytes / frames, uploadedBytes / frames);
+		}
 		SDL_DestroyTexture(texture);
 		if (maskLayer) {
 			SDL_DestroyTexture(maskLayer);
 		}
+		if (pxfmt) {
+			SDL_FreeFormat(pxfmt);
+		}
 		operator delete(conversionBuffer);
 	}
 
 	void Clear() {
+		if (streaming) {
+			// streaming textures can't be render targets
+			void* pixels;
+			int pitch;
+			if (SDL_LockTexture(texture, NULL, &pixels, &pitch) != 0) {
+				Log(ERROR, "SDL20Video", "%s", SDL_GetError());
+				return;
+			}
+			if (nativeFormat == SDL_PIXELFORMAT_YV12) {
+				// black is no luma and neutral chroma; both chroma planes follow the luma one
+				memset(pixels, 0, pitch * rect.h);
+				memset((Uint8*)pixels + pitch * rect.h, 0x80, (pitch / 2) * (rect.h / 2) * 2);
+			} else {
+				memset(pixels, 0, pitch * rect.h);
+			}
+			SDL_UnlockTexture(texture);
+			return;
+		}
+
 		SDL_SetRenderTarget(renderer, texture);
 		SDL_SetRenderDrawColor(renderer, 0, 0, 0, SDL_ALPHA_TRANSPARENT);
 		SDL_RenderClear(renderer);
@@ -190,6 +254,8 @@ public:
 	void CopyPixels(const Region& bufDest, const void* pixelBuf, const int* pitch = NULL, ...) {
 		int sdlpitch = bufDest.w * SDL_BYTESPERPIXEL(nativeFormat);
 		SDL_Rect dest = RectFromRegion(bufDest);
+		int ret = 0;
+		frames++;
 
 		if (nativeFormat == SDL_PIXELFORMAT_YV12) {
 			va_list args;
@@ -207,9 +273,32 @@ public:
 			strides[V] = *va_arg(args, int*);
 			va_end(args);
 
-			SDL_UpdateYUVTexture(texture, &dest, planes[Y], strides[Y], planes[V], strides[V], planes[U], strides[U]);
+			// the planes are uploaded straight from the decoder's frame
+			ret = SDL_UpdateYUVTexture(texture, &dest, planes[Y], strides[Y], planes[V], strides[V], planes[U], strides[U]);
+			uploadedBytes += bufDest.w * bufDest.h * 3 / 2;
 		} else if (nativeFormat == inputFormat) {
-			SDL_UpdateTexture(texture, &dest, pixelBuf, (pitch) ? *pitch : sdlpitch);
+			ret = SDL_UpdateTexture(texture, &dest, pixelBuf, (pitch) ? *pitch : sdlpitch);
+			uploadedBytes += sdlpitch * bufDest.h;
+		} else if (conversionBuffer == NULL) {
+			// convert directly into the texture memory
+			void* pixels;
+			int texpitch;
+			ret = SDL_LockTexture(texture, &dest, &pixels, &texpitch);
+			if (ret == 0) {
+				if (inputFormat == SDL_PIXELFORMAT_INDEX8) {
+					va_list args;
+					va_start(args, pitch);
+					Palette* pal = va_arg(args, Palette*);
+					va_end(args);
+
+					ConvertPalettized(static_cast<const Uint8*>(pixelBuf), pal, bufDest.w, bufDest.h, static_cast<Uint8*>(pixels), texpitch);
+				} else {
+					int srcpitch = (pitch) ? *pitch : bufDest.w * SDL_BYTESPERPIXEL(inputFormat);
+					ret = SDL_ConvertPixels(bufDest.w, bufDest.h, inputFormat, pixelBuf, srcpitch, nativeFormat, pixels, texpitch);
+				}
+				SDL_UnlockTexture(texture);
+				uploadedBytes += sdlpitch * bufDest.h;
+			}
 		} else if (inputFormat == SDL_PIXELFORMAT_INDEX8) {
 			// SDL_ConvertPixels doesn't support palettes... must do it ourselves
 			va_list args;
@@ -217,34 +306,22 @@ public:
 			Palette* pal = va_arg(args, Palette*);
 			va_end(args);
 
-			Uint32* dst = static_cast<Uint32*>(conversionBuffer);
-			SDL_PixelFormat* pxfmt = SDL_AllocFormat(nativeFormat);
-			bool hasalpha = SDL_ISPIXELFORMAT_ALPHA(nativeFormat);
-
-			const Uint8* src = static_cast<const Uint8*>(pixelBuf);
-			for (int xy = 0; xy < bufDest.w * bufDest.h; ++xy) {
-				const Color& c = pal->col[*src++];
-				*dst++ = (c.r << pxfmt->Rshift) | (c.g << pxfmt->Gshift) | (c.b << pxfmt->Bshift) | (c.a << pxfmt->Ashift);
-				if (hasalpha == false) {
-					dst = (Uint32*)((Uint8*)dst - 1);
-				}
-			}
-
-			SDL_FreeFormat(pxfmt);
-
-			int ret = SDL_UpdateTexture(texture, &dest, conversionBuffer, sdlpitch);
-			if (ret != 0) {
-				Log(ERROR, "SDL20Video", "%s", SDL_GetError());
-			}
+			ConvertPalettized(static_cast<const Uint8*>(pixelBuf), pal, bufDest.w, bufDest.h, static_cast<Uint8*>(conversionBuffer), sdlpitch);
+			ret = SDL_UpdateTexture(texture, &dest, conversionBuffer, sdlpitch);
+			stagedBytes += sdlpitch * bufDest.h;
+			uploadedBytes += sdlpitch * bufDest.h;
 		} else {
-			int ret = SDL_ConvertPixels(bufDest.w, bufDest.h, inputFormat, pixelBuf, (pitch) ? *pitch : sdlpitch, nativeFormat, conversionBuffer, sdlpitch);
+			int srcpitch = (pitch) ? *pitch : bufDest.w * SDL_BYTESPERPIXEL(inputFormat);
+			ret = SDL_ConvertPixels(bufDest.w, bufDest.h, inputFormat, pixelBuf, srcpitch, nativeFormat, conversionBuffer, sdlpitch);
 			if (ret == 0) {
 				ret = SDL_UpdateTexture(texture, &dest, conversionBuffer, sdlpitch);
 			}
+			stagedBytes += sdlpitch * bufDest.h;
+			uploadedBytes += sdlpitch * bufDest.h;
+		}
 
-			if (ret != 0) {
-				Log(ERROR, "SDL20Video", "%s", SDL_GetError());
-			}
+		if (ret != 0) {
+			Log(ERROR, "SDL20Video", "%s", SDL_GetError());
 		}
 	}
 
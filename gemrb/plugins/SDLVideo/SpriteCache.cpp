@@ -0,0 +1,217 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2018 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#include "SpriteCache.h"
+
+#include "Video.h"
+#include "System/Logging.h"
+
+namespace GemRB {
+
+SpriteCache::SpriteCache(size_t budget)
+: budget(budget)
+{
+	memset(&stats, 0, sizeof(stats));
+}
+
+SpriteCache::~SpriteCache()
+{
+	Clear();
+}
+
+void SpriteCache::Clear()
+{
+	EntryMap::iterator it = entries.begin();
+	for (; it != entries.end(); ++it) {
+		delete it->second;
+	}
+	entries.clear();
+	lru.clear();
+	stats.bytes = 0;
+	stats.entries = 0;
+}
+
+bool SpriteCache::CanCache(unsigned int flags, bool covered)
+{
+	// the shadow alpha depends on the cover
+	if (covered && (flags & (BLIT_HALFTRANS | BLIT_TRANSSHADOW))) {
+		return false;
+	}
+	// these are drawn with SRShadow_HalfTrans, which blends the shadow differently
+	if (flags == BLIT_HALFTRANS || flags == (BLIT_TINTED | BLIT_TRANSSHADOW)) {
+		return false;
+	}
+	return true;
+}
+
+const Uint32* SpriteCache::Lookup(const Sprite2D* spr, Palette* pal, unsigned int flags, const Color& tint)
+{
+	assert(spr && spr->BAM && spr->RLE && pal);
+
+	Key key;
+	key.sprite = spr;
+	key.palette = pal;
+	key.flags = flags;
+	key.tint = (flags & BLIT_TINTED) ? (tint.r | tint.g << 8 | tint.b << 16 | (Uint32)tint.a << 24) : 0;
+
+	Entry* entry = NULL;
+	EntryMap::iterator it = entries.find(key);
+	if (it == entries.end()) {
+		// first sighting; just remember it
+		entry = new Entry();
+		entry->self = entries.insert(std::make_pair(key, entry)).first;
+		lru.push_front(entry);
+		entry->lru = lru.begin();
+		entry->size = sizeof(Entry);
+		stats.bytes += entry->size;
+		stats.entries++;
+		stats.misses++;
+		Trim();
+		return NULL;
+	}
+
+	entry = it->second;
+	lru.splice(lru.begin(), lru, entry->lru);
+
+	// the version alone can't be trusted, since the colors are public
+	if (entry->pixels && entry->palAlpha == pal->alpha
+		&& memcmp(entry->colors, pal->col, sizeof(entry->colors)) == 0) {
+		stats.hits++;
+		return entry->pixels;
+	}
+
+	// either the second sighting or the palette was modified since we expanded it
+	stats.misses++;
+	entry->sprite = const_cast<Sprite2D*>(spr);
+	entry->palette = pal;
+	memcpy(entry->colors, pal->col, sizeof(entry->colors));
+	entry->palAlpha = pal->alpha;
+	Expand(entry, flags, tint);
+	Trim();
+	// the entry may have been too big to keep
+	if (entries.find(key) == entries.end()) {
+		return NULL;
+	}
+	return entry->pixels;
+}
+
+void SpriteCache::Expand(Entry* entry, unsigned int flags, const Color& tint)
+{
+	const Sprite2D* spr = entry->sprite.get();
+	const Palette* pal = entry->palette.get();
+	const Uint8 transindex = (Uint8)spr->GetColorKey();
+
+	// first resolve the whole palette, then the pixels are a simple lookup
+	Uint32 expanded[256];
+	for (int i = 0; i < 256; ++i) {
+		Color c = pal->col[i];
+
+		if (i == transindex || (i == 1 && (flags & BLIT_NOSHADOW))) {
+			expanded[i] = 0;
+			continue;
+		}
+
+		unsigned int shift = 8;
+		if (flags & (BLIT_GREY|BLIT_SEPIA)) shift += 2;
+		if (flags & BLIT_TINTED) {
+			c.r = (tint.r * c.r) >> shift;
+			c.g = (tint.g * c.g) >> shift;
+			c.b = (tint.b * c.b) >> shift;
+		} else if (shift > 8) {
+			c.r >>= 2;
+			c.g >>= 2;
+			c.b >>= 2;
+		}
+
+		if (flags & BLIT_GREY) {
+			Uint8 avg = c.r + c.g + c.b;
+			c.r = c.g = c.b = avg;
+		} else if (flags & BLIT_SEPIA) {
+			Uint8 avg = c.r + c.g + c.b;
+			c.r = avg + 21; // can't overflow, since avg is at most 189
+			c.g = avg;
+			c.b = avg < 32 ? 0 : avg - 32;
+		}
+
+		if (!pal->alpha) {
+			c.a = (flags & BLIT_TINTED) ? tint.a : 255;
+		} else if (flags & BLIT_TINTED) {
+			c.a = (tint.a * c.a) >> 8;
+		}
+		if ((flags & BLIT_HALFTRANS) || (i == 1 && (flags & BLIT_TRANSSHADOW))) {
+			c.a >>= 1;
+		}
+		// a zero alpha would mean "skip", which is equivalent anyway
+		expanded[i] = c.r | c.g << 8 | c.b << 16 | (Uint32)c.a << 24;
+	}
+
+	size_t numPx = spr->Width * spr->Height;
+	if (entry->pixels == NULL) {
+		entry->pixels = (Uint32*) malloc(numPx * sizeof(Uint32));
+		entry->size += numPx * sizeof(Uint32);
+		stats.bytes += numPx * sizeof(Uint32);
+	}
+
+	const Uint8* src = static_cast<const Uint8*>(spr->LockSprite());
+	Uint32* dst = entry->pixels;
+	Uint32* end = dst + numPx;
+	while (dst < end) {
+		Uint8 p = *src++;
+		if (p == transindex) {
+			int count = (int)(*src++) + 1;
+			// the last run may be padded past the end of the frame
+			if (count > end - dst) count = end - dst;
+			memset(dst, 0, count * sizeof(Uint32));
+			dst += count;
+		} else {
+			*dst++ = expanded[p];
+		}
+	}
+	spr->UnlockSprite();
+
+	stats.expansions++;
+}
+
+void SpriteCache::Evict(Entry* entry)
+{
+	stats.bytes -= entry->size;
+	stats.entries--;
+	stats.evictions++;
+	lru.erase(entry->lru);
+	entries.erase(entry->self);
+	delete entry;
+}
+
+void SpriteCache::Trim()
+{
+	while (stats.bytes > budget && !lru.empty()) {
+		Evict(lru.back());
+	}
+}
+
+void SpriteCache::LogStats() const
+{
+	unsigned long lookups = stats.hits + stats.misses;
+	Log(DEBUG, "SpriteCache", "%lu lookups, %.1f%% hit rate, %lu expansions, %lu evictions, %lu entries using %lu/%lu bytes",
+		lookups, (lookups) ? 100.0 * stats.hits / lookups : 0.0, stats.expansions, stats.evictions,
+		(unsigned long)stats.entries, (unsigned long)stats.bytes, (unsigned long)budget);
+}
+
+}
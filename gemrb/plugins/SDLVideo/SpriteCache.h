@@ -0,0 +1,131 @@
+/* GemRB - Infinity Engine Emulator
+ * Copyright (C) 2018 The GemRB Project
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ *
+ */
+
+#ifndef SPRITECACHE_H
+#define SPRITECACHE_H
+
+#include "Holder.h"
+#include "Palette.h"
+#include "Sprite2D.h"
+
+#include <SDL.h>
+#include <list>
+#include <map>
+
+namespace GemRB {
+
+// default memory budget for the expanded pixels (not counting bookkeeping)
+#define SPRITE_CACHE_SIZE (16*1024*1024)
+
+/**
+ * @class SpriteCache
+ * Keeps 32 bit copies of RLE encoded BAM frames with the palette, tint, shadow
+ * and greyscale/sepia handling already applied, so the software blitter
+ * does not have to decode and run every pixel through the tinter each frame.
+ *
+ * The expanded pixels are stored as r | g << 8 | b << 16 | a << 24,
+ * unflipped and without the cover applied, as expected by BlitSpriteRGB.
+ * An alpha of 0 marks a pixel that must not be drawn at all.
+ * Since the shadow alpha is baked in, covered blits with BLIT_HALFTRANS or
+ * BLIT_TRANSSHADOW can't use the cache. Neither can the combinations with a
+ * dedicated half transparent shadow blitter (see CanCache), since an alpha
+ * can't reproduce its ((pix>>1)&mask)+shadowcol formula exactly.
+ *
+ * Entries remember the palette colors they were expanded with, since plenty
+ * of code writes to Palette::col directly without bumping the version.
+ *
+ * A combination is only expanded once it is requested a second time, so
+ * one-off blits (eg. a tint that changes every frame) don't churn the cache.
+ */
+
+class SpriteCache {
+public:
+	struct Stats {
+		unsigned long hits;
+		unsigned long misses;
+		unsigned long expansions;
+		unsigned long evictions;
+		size_t bytes;
+		size_t entries;
+	};
+
+private:
+	struct Key {
+		const Sprite2D* sprite;
+		const Palette* palette;
+		unsigned int flags;
+		Uint32 tint;
+
+		bool operator<(const Key& rhs) const {
+			if (sprite != rhs.sprite) return sprite < rhs.sprite;
+			if (palette != rhs.palette) return palette < rhs.palette;
+			if (flags != rhs.flags) return flags < rhs.flags;
+			return tint < rhs.tint;
+		}
+	};
+
+	struct Entry;
+	typedef std::map<Key, Entry*> EntryMap;
+	typedef std::list<Entry*> LRUList;
+
+	struct Entry {
+		EntryMap::iterator self;
+		LRUList::iterator lru;
+		// holding references ensures the key pointers can't be recycled while we are cached
+		Holder<Sprite2D> sprite;
+		Holder<Palette> palette;
+		Color colors[256]; // the palette contents the pixels were expanded with
+		bool palAlpha;
+		Uint32* pixels;
+		size_t size;
+
+		Entry() : palAlpha(false), pixels(NULL), size(0) {}
+		~Entry() { free(pixels); }
+	};
+
+	EntryMap entries;
+	LRUList lru; // most recently used at the front
+	size_t budget;
+	Stats stats;
+
+public:
+	SpriteCache(size_t budget = SPRITE_CACHE_SIZE);
+	~SpriteCache();
+
+	/** Returns false for flag combinations that must not go through the cache at all */
+	static bool CanCache(unsigned int flags, bool covered);
+	/** Returns the expanded pixels for the combination or NULL if it isn't (yet) worth caching.
+	 * 'flags' must already contain all the implicit flags of the blitter, while
+	 * 'tint' is only taken into account if BLIT_TINTED is set. */
+	const Uint32* Lookup(const Sprite2D* spr, Palette* pal, unsigned int flags, const Color& tint);
+	void Clear();
+
+	const Stats& GetStats() const { return stats; }
+	void LogStats() const;
+
+private:
+	void Expand(Entry* entry, unsigned int flags, const Color& tint);
+	void Evict(Entry* entry);
+	void Trim();
+};
+
+}
+
+#endif
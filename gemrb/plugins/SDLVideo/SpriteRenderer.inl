@@ -683,17 +683,22 @@ static void BlitSpriteRGB_internal(SDL_Surface* target,
 	const int yfactor = yflip ? -1 : 1;
 	const int xfactor = XFLIP ? -1 : 1;
 
+	Uint32 amask = target->format->Amask;
+
 	while (line != end) {
 		do {
 			Uint32 p = *srcdata++;
 			Uint8 a = (Uint8)(p >> 24);
 			if (a != 0) {
-				if (!COVER || !*coverpix) {
+				// same cover handling as the RLE blitter
+				if (!COVER || *coverpix < 0xff) {
 					Uint8 r = (Uint8)(p);
 					Uint8 g = (Uint8)(p >> 8);
 					Uint8 b = (Uint8)(p >> 16);
 					tint(r, g, b, a, flags);
+					a = COVER ? a - *coverpix : a;
 					blend(*pix, r, g, b, a);
+					*pix |= amask;
 				}
 #ifdef HIGHLIGHTCOVER
 				else if (COVER) {
@@ -512,6 +512,11 @@ bool TLKImporter::HasAltTLK() const
 	return Language;
 }
 
+ieStrRef TLKImporter::GetStringCount() const
+{
+	return StrRefCount;
+}
+
 StringBlock TLKImporter::GetStringBlock(ieStrRef strref, unsigned int flags)
 {
 	if (!(flags&IE_STR_ALLOW_ZERO) && !strref) {
@@ -52,6 +52,7 @@ public:
 	StringBlock GetStringBlock(ieStrRef strref, unsigned int flags = 0);
 	void FreeString(char *str);
 	bool HasAltTLK() const;
+	ieStrRef GetStringCount() const;
 private:
 	/** resolves day and monthname tokens */
 	void GetMonthName(int dayandmonth);
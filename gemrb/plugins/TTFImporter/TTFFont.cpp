@@ -22,14 +22,16 @@
 #include "Interface.h"
 #include "Sprite2D.h"
 #include "Video.h"
+#include "System/FileStream.h"
 
 #define uint8_t unsigned char
 
 #if HAVE_ICONV
-#include <iconv.h>
 #include <errno.h>
 #endif
 
+#define GLYPH_CACHE_SIGNATURE "GLYC V1 "
+
 namespace GemRB {
 
 const Glyph& TTFFont::AliasBlank(ieWord chr) const
@@ -41,7 +43,7 @@ const Glyph& TTFFont::AliasBlank(ieWord chr) const
 const Glyph& TTFFont::GetGlyph(ieWord chr) const
 {
 #if HAVE_ICONV
-	if (!core->TLKEncoding.multibyte) {
+	if (cd != (iconv_t)-1) {
 		char* oldchar = (char*)&chr;
 		ieWord unicodeChr = 0;
 		char* newchar = (char*)&unicodeChr;
@@ -49,7 +51,6 @@ const Glyph& TTFFont::GetGlyph(ieWord chr) const
 
 		// TODO: make this work on BE systems
 		// TODO: maybe we want to work with non-unicode fonts?
-		iconv_t cd = iconv_open("UTF-16LE", core->TLKEncoding.encoding.c_str());
 	#if __FreeBSD__
 		size_t ret = iconv(cd, (const char **)&oldchar, &in, &newchar, &out);
 	#else
@@ -58,7 +59,6 @@ const Glyph& TTFFont::GetGlyph(ieWord chr) const
 		if (ret != GEM_OK) {
 			Log(ERROR, "FONT", "iconv error: %d", errno);
 		}
-		iconv_close(cd);
 		chr = unicodeChr;
 	}
 #endif
@@ -176,14 +176,123 @@ const Glyph& TTFFont::GetGlyph(ieWord chr) const
 
 	// TODO: do an underline if requested
 
-	Sprite2D* spr = core->GetVideoDriver()->CreateSprite8(sprSize.w, sprSize.h, pixels, palette, true, 0);
-	spr->YPos = FT_FLOOR(metrics->horiBearingY);
+	return CreateGlyph(chr, pixels, sprSize, FT_FLOOR(metrics->horiBearingY));
+}
+
+const Glyph& TTFFont::CreateGlyph(ieWord chr, ieByte* pixels, const Size& size, int ypos) const
+{
+	// remember the pixels for the glyph cache
+	CachedGlyph cached;
+	cached.chr = chr;
+	cached.ypos = ypos;
+	cached.w = size.w;
+	cached.h = size.h;
+	cached.offset = cachePixels.size();
+	cachePixels.insert(cachePixels.end(), pixels, pixels + size.w * size.h);
+	cachedGlyphs.push_back(cached);
+	cacheDirty = true;
+
+	Sprite2D* spr = core->GetVideoDriver()->CreateSprite8(size.w, size.h, pixels, palette, true, 0);
+	spr->YPos = ypos;
 	// FIXME: casting away const
 	const Glyph& ret = ((TTFFont*)this)->CreateGlyphForCharSprite(chr, spr);
 	spr->release();
 	return ret;
 }
 
+void TTFFont::Prerender(const String& chars) const
+{
+	for (size_t i = 0; i < chars.length(); i++) {
+		GetGlyph(chars[i]);
+	}
+}
+
+bool TTFFont::LoadGlyphCache(const char* path)
+{
+	strlcpy(cacheFile, path, _MAX_PATH);
+	FileStream* str = FileStream::OpenFile(cacheFile);
+	if (!str) {
+		return false;
+	}
+
+	// the face and size are part of the file name, but make sure the metrics still match
+	char signature[8];
+	ieWord lineHeight, baseline;
+	ieDword numGlyphs, count;
+	str->Read(signature, 8);
+	str->ReadWord(&lineHeight);
+	str->ReadWord(&baseline);
+	str->ReadDword(&numGlyphs);
+	str->ReadDword(&count);
+	if (memcmp(signature, GLYPH_CACHE_SIGNATURE, 8) || lineHeight != LineHeight || baseline != Baseline
+		|| numGlyphs != (ieDword) face->num_glyphs) {
+		Log(WARNING, "TTFFont", "Ignoring stale glyph cache %s", cacheFile);
+		delete str;
+		return false;
+	}
+
+	for (ieDword i = 0; i < count; i++) {
+		ieWord chr, w, h;
+		ieWordSigned ypos;
+		str->ReadWord(&chr);
+		str->ReadWordSigned(&ypos);
+		str->ReadWord(&w);
+		str->ReadWord(&h);
+		if (str->Remains() < (unsigned long) w * h) {
+			Log(WARNING, "TTFFont", "Glyph cache %s is truncated", cacheFile);
+			break;
+		}
+		if (!w || !h) {
+			// nothing to draw (eg. a space), it is simply rendered again when needed
+			continue;
+		}
+		ieByte* pixels = (ieByte*) malloc(w * h);
+		str->Read(pixels, w * h);
+		if (Font::GetGlyph(chr).pixels) {
+			// already there (eg. whitespace)
+			free(pixels);
+			continue;
+		}
+		CreateGlyph(chr, pixels, Size(w, h), ypos);
+	}
+	delete str;
+
+	cacheDirty = false;
+	return true;
+}
+
+void TTFFont::SaveGlyphCache()
+{
+	if (!cacheDirty || !cacheFile[0]) {
+		return;
+	}
+
+	FileStream str;
+	if (!str.Create(cacheFile)) {
+		Log(WARNING, "TTFFont", "Unable to write glyph cache %s", cacheFile);
+		return;
+	}
+	ieWord lineHeight = LineHeight;
+	ieWord baseline = Baseline;
+	ieDword numGlyphs = face->num_glyphs;
+	ieDword count = cachedGlyphs.size();
+	str.Write(GLYPH_CACHE_SIGNATURE, 8);
+	str.WriteWord(&lineHeight);
+	str.WriteWord(&baseline);
+	str.WriteDword(&numGlyphs);
+	str.WriteDword(&count);
+	for (size_t i = 0; i < cachedGlyphs.size(); i++) {
+		const CachedGlyph& g = cachedGlyphs[i];
+		ieWord ypos = g.ypos;
+		str.WriteWord(&g.chr);
+		str.WriteWord(&ypos);
+		str.WriteWord(&g.w);
+		str.WriteWord(&g.h);
+		str.Write(&cachePixels[g.offset], g.w * g.h);
+	}
+	cacheDirty = false;
+}
+
 int TTFFont::GetKerningOffset(ieWord leftChr, ieWord rightChr) const
 {
 	FT_UInt leftIndex = FT_Get_Char_Index(face, leftChr);
@@ -202,6 +311,15 @@ int TTFFont::GetKerningOffset(ieWord leftChr, ieWord rightChr) const
 TTFFont::TTFFont(Palette* pal, FT_Face face, int lineheight, int baseline)
 	: Font(pal, lineheight, baseline), face(face)
 {
+	cacheDirty = false;
+	cacheFile[0] = 0;
+#if HAVE_ICONV
+	cd = (iconv_t)-1;
+	if (!core->TLKEncoding.multibyte) {
+		cd = iconv_open("UTF-16LE", core->TLKEncoding.encoding.c_str());
+	}
+#endif
+
 // on FT < 2.4.2 the manager will defer ownership to this object
 #if FREETYPE_VERSION_ATLEAST(2,4,2)
 	FT_Reference_Face(face); // retain the face or the font manager will destroy it
@@ -220,6 +338,12 @@ TTFFont::TTFFont(Palette* pal, FT_Face face, int lineheight, int baseline)
 
 TTFFont::~TTFFont()
 {
+	SaveGlyphCache();
+#if HAVE_ICONV
+	if (cd != (iconv_t)-1) {
+		iconv_close(cd);
+	}
+#endif
 	FT_Done_Face(face);
 }
 
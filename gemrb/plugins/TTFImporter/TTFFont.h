@@ -27,14 +27,38 @@
 #include "HashMap.h"
 #include "Holder.h"
 
+#include <vector>
+
+#if HAVE_ICONV
+#include <iconv.h>
+#endif
+
 namespace GemRB {
 
 class TTFFont : public Font
 {
 private:
 	FT_Face face;
+#if HAVE_ICONV
+	// converting from the TLK encoding, opened only once since GetGlyph is called for every printed character
+	iconv_t cd;
+#endif
+
+	// every glyph we rendered (or loaded), so the glyph cache can be written back
+	struct CachedGlyph {
+		ieWord chr;
+		ieWordSigned ypos;
+		ieWord w, h;
+		size_t offset; // into cachePixels
+	};
+	mutable std::vector<CachedGlyph> cachedGlyphs;
+	mutable std::vector<ieByte> cachePixels;
+	mutable bool cacheDirty;
+	char cacheFile[_MAX_PATH];
 
 	const Glyph& AliasBlank(ieWord chr) const;
+	// takes ownership of pixels
+	const Glyph& CreateGlyph(ieWord chr, ieByte* pixels, const Size& size, int ypos) const;
 
 public:
 	TTFFont(Palette* pal, FT_Face face, int lineheight, int baseline);
@@ -42,6 +66,13 @@ public:
 
 	const Glyph& GetGlyph(ieWord chr) const;
 	int GetKerningOffset(ieWord leftChr, ieWord rightChr) const;
+
+	// the glyph cache keeps the rendered glyphs between runs, so printing doesn't have to wait for FreeType
+	// returns false if there was no usable cache file
+	bool LoadGlyphCache(const char* path);
+	void SaveGlyphCache();
+	// render the glyphs for all the characters in the string ahead of time
+	void Prerender(const String& chars) const;
 };
 
 }
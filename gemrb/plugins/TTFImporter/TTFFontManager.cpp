@@ -20,8 +20,13 @@
 
 #include "Interface.h"
 #include "Palette.h"
+#include "StringMgr.h"
 #include "TTFFont.h"
 #include "TTFFontManager.h"
+#include "System/VFS.h"
+
+#include <algorithm>
+#include <vector>
 
 using namespace GemRB;
 
@@ -43,6 +48,62 @@ static void destroyFT()
 	}
 }
 
+// fonts without a glyph cache render this many of the most used TLK characters up front
+// all of them would mean thousands of glyphs per font with CJK translations
+#define MAX_PRERENDERED_GLYPHS 512
+
+static bool MoreFrequent(const std::pair<ieDword, ieWord>& a, const std::pair<ieDword, ieWord>& b)
+{
+	return a.first > b.first;
+}
+
+// the most frequent characters in the TLK, most frequent first
+// collected only once, since it means going through all the strings
+static const String& TLKCharacters()
+{
+	static String chars;
+	static bool collected = false;
+	if (collected) {
+		return chars;
+	}
+	collected = true;
+
+	std::vector<ieDword> counts(0x10000, 0);
+	ieStrRef count = core->strings->GetStringCount();
+	for (ieStrRef strref = 1; strref < count; strref++) {
+		String* string = core->strings->GetString(strref);
+		for (size_t i = 0; i < string->length(); i++) {
+			counts[(ieWord) (*string)[i]]++;
+		}
+		delete string;
+	}
+
+	std::vector<std::pair<ieDword, ieWord> > used;
+	for (size_t chr = 0; chr < counts.size(); chr++) {
+		if (counts[chr]) {
+			used.push_back(std::make_pair(counts[chr], (ieWord) chr));
+		}
+	}
+	size_t keep = std::min(used.size(), (size_t) MAX_PRERENDERED_GLYPHS);
+	std::partial_sort(used.begin(), used.begin() + keep, used.end(), MoreFrequent);
+	for (size_t i = 0; i < keep; i++) {
+		chars.push_back(used[i].second);
+	}
+	return chars;
+}
+
+// the glyph bitmaps don't depend on the palette, but the fonts made from the same file
+// and size must not share (and overwrite) a cache file
+static ieDword PaletteHash(const Palette* pal)
+{
+	ieDword hash = 2166136261u;
+	const ieByte* bytes = (const ieByte*) pal->col;
+	for (size_t i = 0; i < sizeof(pal->col); i++) {
+		hash = (hash ^ bytes[i]) * 16777619u;
+	}
+	return hash;
+}
+
 unsigned long TTFFontManager::read(FT_Stream		stream,
 								   unsigned long	offset,
 								   unsigned char*	buffer,
@@ -73,7 +134,9 @@ TTFFontManager::~TTFFontManager(void)
 
 TTFFontManager::TTFFontManager(void)
 : ftStream(NULL), face(NULL)
-{}
+{
+	fontName[0] = 0;
+}
 
 bool TTFFontManager::Open(DataStream* stream)
 {
@@ -102,6 +165,7 @@ bool TTFFontManager::Open(DataStream* stream)
 		// we always convert to UTF-16
 		// TODO: maybe we should allow an override encoding?
 		FT_Select_Charmap(face, FT_ENCODING_UNICODE);
+		strlcpy(fontName, stream->filename, sizeof(fontName));
 		return true;
 	}
 	return false;
@@ -116,7 +180,7 @@ void TTFFontManager::Close()
 }
 
 Font* TTFFontManager::GetFont(unsigned short pxSize,
-							  FontStyle /*style*/, Palette* pal)
+							  FontStyle style, Palette* pal)
 {
 	if (!pal) {
 		pal = new Palette( ColorWhite, ColorBlack );
@@ -169,7 +233,22 @@ Font* TTFFontManager::GetFont(unsigned short pxSize,
 		//font->underline_height = FT_FLOOR(face->underline_thickness);
 	}
 
-	return new TTFFont(pal, face, lineHeight, baseline);
+	TTFFont* font = new TTFFont(pal, face, lineHeight, baseline);
+
+	// glyphs printed later are added to the cache when the font goes away
+	char path[_MAX_PATH];
+	strlcpy(path, core->GlyphCachePath, sizeof(path));
+	if (fontName[0] && MakeDirectories(path)) {
+		char cacheName[_MAX_PATH];
+		snprintf(cacheName, sizeof(cacheName), "%s-%d-%d-%08x", fontName, pxSize, style, PaletteHash(pal));
+		PathJoinExt(path, path, cacheName, "gly");
+		if (!font->LoadGlyphCache(path)) {
+			// first run with this font, render the most common characters up front
+			font->Prerender(TLKCharacters());
+			font->SaveGlyphCache();
+		}
+	}
+	return font;
 }
 
 #include "plugindef.h"
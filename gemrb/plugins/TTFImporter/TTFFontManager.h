@@ -34,6 +34,7 @@ Private ivars
 private:
 	FT_Stream ftStream;
 	FT_Face face;
+	char fontName[16]; // for naming the glyph caches
 
 public:
 /*